@@ -0,0 +1,276 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using std::cout;
+using std::cerr;
+using std::string;
+using std::vector;
+
+/* Generators for parametric QBF families, written to standard output in
+ * QDIMACS (QCIR for the qcir family). Random families use their own PRNG,
+ * so an instance depends only on its parameters and seed, not on the
+ * standard library it was built with. */
+
+static const char USAGE[] =
+R"(Usage: qute-gen kbkf <t>
+       qute-gen qparity <n>
+       qute-gen chain <n>
+       qute-gen random <blocks> <vars-per-block> <clauses> [<seed>]
+       qute-gen qcir <blocks> <vars-per-block> <gates> [<seed>]
+
+Families:
+  kbkf      formulas of Kleine Buening, Karpinski and Floegel with t universal variables (false)
+  qparity   the parity of n existential variables is forced to equal a universal variable (false)
+  chain     n alternations of an existential and a universal variable, followed by n
+            existential variables that are only satisfiable if each existential differs
+            from the universal after it (false)
+  random    random 2QBF (blocks = 2, forall-exists) or 3QBF (blocks = 3, exists-forall-exists)
+            with clauses of 2 universal and 3 existential literals, resp. 1 outer existential,
+            2 universal and 2 inner existential literals
+  qcir      random circuit over blocks alternating from exists, its output is a conjunction
+            of disjunctions with one literal from each block and two from the innermost
+            existential block
+)";
+
+class SplitMix64 {
+
+public:
+  SplitMix64(uint64_t seed): state(seed) {}
+  uint64_t next() {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+  // Uniform in [0, bound), the modulo bias is negligible for the bounds used here.
+  uint32_t below(uint32_t bound) { return next() % bound; }
+  bool coin() { return next() >> 63; }
+
+private:
+  uint64_t state;
+
+};
+
+struct Block {
+  char quantifier;
+  vector<int> variables;
+};
+
+static void printQDIMACS(int nr_variables, const vector<Block>& prefix, const vector<vector<int>>& clauses) {
+  cout << "p cnf " << nr_variables << " " << clauses.size() << "\n";
+  for (const Block& block: prefix) {
+    cout << block.quantifier;
+    for (int v: block.variables) {
+      cout << " " << v;
+    }
+    cout << " 0\n";
+  }
+  for (const vector<int>& clause: clauses) {
+    for (int l: clause) {
+      cout << l << " ";
+    }
+    cout << "0\n";
+  }
+}
+
+static void kbkf(int t) {
+  // Variables: y_0, then y_i^0, y_i^1, x_i for i = 1..t, then z_1..z_t.
+  int y0 = 1;
+  auto y = [](int i, int b) { return 2 + 3 * (i - 1) + b; };
+  auto x = [](int i) { return 4 + 3 * (i - 1); };
+  auto z = [t](int i) { return 1 + 3 * t + i; };
+  vector<Block> prefix;
+  prefix.push_back({'e', {y0, y(1, 0), y(1, 1)}});
+  for (int i = 1; i <= t; i++) {
+    prefix.push_back({'a', {x(i)}});
+    if (i < t) {
+      prefix.push_back({'e', {y(i + 1, 0), y(i + 1, 1)}});
+    }
+  }
+  prefix.push_back({'e', {}});
+  for (int i = 1; i <= t; i++) {
+    prefix.back().variables.push_back(z(i));
+  }
+  vector<vector<int>> clauses;
+  clauses.push_back({-y0});
+  clauses.push_back({y0, -y(1, 0), -y(1, 1)});
+  for (int i = 1; i < t; i++) {
+    clauses.push_back({y(i, 0), x(i), -y(i + 1, 0), -y(i + 1, 1)});
+    clauses.push_back({y(i, 1), -x(i), -y(i + 1, 0), -y(i + 1, 1)});
+  }
+  for (int b = 0; b <= 1; b++) {
+    vector<int> clause = {y(t, b), b ? -x(t) : x(t)};
+    for (int i = 1; i <= t; i++) {
+      clause.push_back(-z(i));
+    }
+    clauses.push_back(clause);
+  }
+  for (int i = 1; i <= t; i++) {
+    clauses.push_back({x(i), z(i)});
+    clauses.push_back({-x(i), z(i)});
+  }
+  printQDIMACS(z(t), prefix, clauses);
+}
+
+static void addXor(vector<vector<int>>& clauses, int result, int a, int b) {
+  clauses.push_back({-result, a, b});
+  clauses.push_back({-result, -a, -b});
+  clauses.push_back({result, -a, b});
+  clauses.push_back({result, a, -b});
+}
+
+static void qparity(int n) {
+  // x_1..x_n are 1..n, the universal z is n + 1, t_i = x_1 xor ... xor x_i is n + i for i = 2..n.
+  int z = n + 1;
+  auto t = [n](int i) { return i == 1 ? 1 : n + i; };
+  vector<Block> prefix = {{'e', {}}, {'a', {z}}, {'e', {}}};
+  for (int i = 1; i <= n; i++) {
+    prefix[0].variables.push_back(i);
+  }
+  for (int i = 2; i <= n; i++) {
+    prefix[2].variables.push_back(t(i));
+  }
+  vector<vector<int>> clauses;
+  for (int i = 2; i <= n; i++) {
+    addXor(clauses, t(i), t(i - 1), i);
+  }
+  clauses.push_back({z, t(n)});
+  clauses.push_back({-z, -t(n)});
+  printQDIMACS(2 * n, prefix, clauses);
+}
+
+static void chain(int n) {
+  // x_i is 2i - 1, u_i is 2i, t_i is 2n + i.
+  vector<Block> prefix;
+  for (int i = 1; i <= n; i++) {
+    prefix.push_back({'e', {2 * i - 1}});
+    prefix.push_back({'a', {2 * i}});
+  }
+  prefix.push_back({'e', {}});
+  vector<vector<int>> clauses;
+  vector<int> some_t;
+  for (int i = 1; i <= n; i++) {
+    int x = 2 * i - 1, u = 2 * i, t = 2 * n + i;
+    prefix.back().variables.push_back(t);
+    clauses.push_back({x, u, -t});
+    clauses.push_back({-x, -u, -t});
+    some_t.push_back(t);
+  }
+  clauses.push_back(some_t);
+  printQDIMACS(3 * n, prefix, clauses);
+}
+
+static void randomQBF(int nr_blocks, int vars_per_block, int nr_clauses, uint64_t seed) {
+  SplitMix64 random(seed);
+  vector<Block> prefix;
+  vector<int> literals_per_block;
+  if (nr_blocks == 2) {
+    prefix = {{'a', {}}, {'e', {}}};
+    literals_per_block = {2, 3};
+  } else {
+    prefix = {{'e', {}}, {'a', {}}, {'e', {}}};
+    literals_per_block = {1, 2, 2};
+  }
+  for (int b = 0; b < nr_blocks; b++) {
+    for (int i = 1; i <= vars_per_block; i++) {
+      prefix[b].variables.push_back(b * vars_per_block + i);
+    }
+  }
+  vector<vector<int>> clauses;
+  for (int c = 0; c < nr_clauses; c++) {
+    vector<int> clause;
+    for (int b = 0; b < nr_blocks; b++) {
+      for (int k = 0; k < literals_per_block[b]; k++) {
+        // Draw distinct variables, vars_per_block is at least the number of literals per block.
+        int v;
+        bool duplicate;
+        do {
+          v = prefix[b].variables[random.below(vars_per_block)];
+          duplicate = false;
+          for (int l: clause) {
+            duplicate = duplicate || abs(l) == v;
+          }
+        } while (duplicate);
+        clause.push_back(random.coin() ? v : -v);
+      }
+    }
+    clauses.push_back(clause);
+  }
+  printQDIMACS(nr_blocks * vars_per_block, prefix, clauses);
+}
+
+static void qcir(int nr_blocks, int vars_per_block, int nr_gates, uint64_t seed) {
+  SplitMix64 random(seed);
+  cout << "#QCIR-G14\n";
+  for (int b = 0; b < nr_blocks; b++) {
+    cout << (b % 2 ? "forall(" : "exists(");
+    for (int i = 0; i < vars_per_block; i++) {
+      cout << (i ? ", " : "") << "v" << b * vars_per_block + i;
+    }
+    cout << ")\n";
+  }
+  cout << "output(g" << nr_gates << ")\n";
+  // Disjunctions with one literal from each block and two more from the innermost existential block.
+  int innermost_existential = (nr_blocks - 1) / 2 * 2;
+  for (int g = 0; g < nr_gates; g++) {
+    cout << "g" << g << " = or(";
+    for (int b = 0; b < nr_blocks + 2; b++) {
+      int block = b < nr_blocks ? b : innermost_existential;
+      cout << (b ? ", " : "") << (random.coin() ? "-" : "") << "v" << block * vars_per_block + random.below(vars_per_block);
+    }
+    cout << ")\n";
+  }
+  cout << "g" << nr_gates << " = and(";
+  for (int g = 0; g < nr_gates; g++) {
+    cout << (g ? ", " : "") << "g" << g;
+  }
+  cout << ")\n";
+}
+
+static int parameter(const vector<string>& args, size_t index, int minimum) {
+  if (index >= args.size()) {
+    cerr << USAGE;
+    exit(1);
+  }
+  char* end;
+  long value = strtol(args[index].c_str(), &end, 10);
+  if (*end != '\0' || value < minimum) {
+    cerr << "qute-gen: '" << args[index] << "' must be an integer of at least " << minimum << "\n";
+    exit(1);
+  }
+  return value;
+}
+
+int main(int argc, const char** argv)
+{
+  vector<string> args(argv + 1, argv + argc);
+  if (args.empty()) {
+    cerr << USAGE;
+    return 1;
+  }
+  string family = args[0];
+  uint64_t seed = args.size() > 4 ? parameter(args, 4, 0) : 1;
+  if (family == "kbkf" && args.size() == 2) {
+    kbkf(parameter(args, 1, 1));
+  } else if (family == "qparity" && args.size() == 2) {
+    qparity(parameter(args, 1, 2));
+  } else if (family == "chain" && args.size() == 2) {
+    chain(parameter(args, 1, 1));
+  } else if (family == "random" && (args.size() == 4 || args.size() == 5)) {
+    int nr_blocks = parameter(args, 1, 2);
+    if (nr_blocks > 3) {
+      cerr << "qute-gen: random formulas have 2 or 3 blocks\n";
+      return 1;
+    }
+    randomQBF(nr_blocks, parameter(args, 2, 3), parameter(args, 3, 1), seed);
+  } else if (family == "qcir" && (args.size() == 4 || args.size() == 5)) {
+    qcir(parameter(args, 1, 1), parameter(args, 2, 1), parameter(args, 3, 1), seed);
+  } else {
+    cerr << USAGE;
+    return 1;
+  }
+  return 0;
+}
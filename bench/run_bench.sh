@@ -0,0 +1,65 @@
+#!/usr/bin/env bash
+# Generates the benchmark instances and runs qute on them with several option
+# sets, writing one CSV per option set in the format of --machine-readable.
+#
+# usage: run_bench.sh <qute> <qute-gen> <output directory> [<time limit>]
+
+set -euo pipefail
+
+if [[ $# -lt 3 ]]; then
+  echo "usage: $0 <qute> <qute-gen> <output directory> [<time limit>]" >&2
+  exit 1
+fi
+
+qute=$1
+qute_gen=$2
+out=$3
+time_limit=${4:-60}
+
+instances=(
+  "kbkf 10"
+  "kbkf 20"
+  "kbkf 40"
+  "qparity 8"
+  "qparity 12"
+  "qparity 16"
+  "chain 10"
+  "chain 20"
+  "random 2 50 270 2"
+  "random 2 60 300 1"
+  "random 3 30 400 1"
+  "random 3 40 800 1"
+  "qcir 3 30 400 1"
+  "qcir 5 30 800 2"
+  "qcir 5 30 900 3"
+)
+
+declare -A option_sets=(
+  [default]=""
+  [deplearn-off]="--dependency-learning off"
+  [deplearn-outermost]="--dependency-learning outermost"
+  [watched-literals-3]="--watched-literals 3"
+  [depscheme-rrs]="--dependency-learning off --depscheme rrs"
+  [depscheme-upure]="--dependency-learning off --depscheme upure"
+)
+
+mkdir -p "$out/instances"
+files=()
+for instance in "${instances[@]}"; do
+  read -r family parameters <<< "$instance"
+  extension=qdimacs
+  [[ $family == qcir ]] && extension=qcir
+  file="$out/instances/${family}_${parameters// /_}.$extension"
+  "$qute_gen" $family $parameters > "$file"
+  files+=("$file")
+done
+
+for name in $(printf '%s\n' "${!option_sets[@]}" | sort); do
+  csv="$out/$name.csv"
+  "$qute" --machine-readable-header > "$csv"
+  for file in "${files[@]}"; do
+    # qute exits with 10 or 20 on a result, and with 0 on a timeout.
+    "$qute" ${option_sets[$name]} --machine-readable -t "$time_limit" "$file" >> "$csv" || true
+  done
+  echo "$name: $csv"
+done
@@ -10,7 +10,7 @@ _qute_complete()
 			COMPREPLY=( $(compgen -W "${OPTS_ALL[*]}" -- $cur) )
 			return 0
 			;;
-		"--decision-heuristic")
+		"--decision-heuristic"|"--stable-decision-heuristic")
 			OPTS_ALL="VSIDS VMTF SGDB" #TODO only offer VSIDS and SGDB as long as DL is on
 			COMPREPLY=( $(compgen -W "${OPTS_ALL[*]}" -- $cur) )
 			return 0
@@ -45,11 +45,31 @@ _qute_complete()
 			COMPREPLY=( $(compgen -W "${OPTS_ALL[*]}" -- $cur) )
 			return 0
 			;;
+		"--target-phases")
+			OPTS_ALL="off existential universal all"
+			COMPREPLY=( $(compgen -W "${OPTS_ALL[*]}" -- $cur) )
+			return 0
+			;;
 		"--depscheme")
 			OPTS_ALL="off rrs upure"
 			COMPREPLY=( $(compgen -W "${OPTS_ALL[*]}" -- $cur) )
 			return 0
 			;;
+		"--depscheme-backend")
+			OPTS_ALL="queue bitparallel"
+			COMPREPLY=( $(compgen -W "${OPTS_ALL[*]}" -- $cur) )
+			return 0
+			;;
+		"--vsids-queue")
+			OPTS_ALL="heap buckets"
+			COMPREPLY=( $(compgen -W "${OPTS_ALL[*]}" -- $cur) )
+			return 0
+			;;
+		"--ema-signal")
+			OPTS_ALL="learned combined"
+			COMPREPLY=( $(compgen -W "${OPTS_ALL[*]}" -- $cur) )
+			return 0
+			;;
 	esac
 	case $cur in
 		-*)
@@ -67,25 +87,36 @@ _qute_complete()
 					--restarts
 					--model-generation
 					--dependency-learning
+					--dependency-learning-batch
 					--watched-literals
 					--out-of-order-decisions
 					--depscheme
 					--depscheme-term-learning-unsafe
+					--depscheme-precompute
+					--depscheme-threads
+					--depscheme-backend
+					--depscheme-cache
 					--no-phase-saving
 					--phase-heuristic
+					--target-phases
+					--rephase-interval
 					--partial-certificate
 					-v --verbose
 					--print-stats
 					--machine-readable
 					--machine-readable-header
 					--trace
+					--dump-binary
+					--record-heuristic-events
 					-t --time-limit
 					--exponent
 					--scaling-factor
 					--universal-penalty
+					--bump-conflict-side
 					--tiebreak
 					--var-activity-inc
 					--var-activity-decay
+					--vsids-queue
 					--initial-learning-rate
 					--learning-rate-decay
 					--learning-rate-minimum
@@ -94,9 +125,17 @@ _qute_complete()
 					--alpha
 					--minimum-distance
 					--threshold-factor
+					--term-threshold-factor
+					--ema-signal
+					--blocking-factor
 					--inner-restart-distance
 					--outer-restart-distance
 					--restart-multiplier
+					--mode-switching
+					--stable-decision-heuristic
+					--stable-luby-multiplier
+					--mode-switch-interval
+					--mode-switch-multiplier
 					--sms-vertices
 					--sms-cutoff
 					--E --enumerate"
@@ -0,0 +1,142 @@
+#ifndef activity_bucket_queue_hh
+#define activity_bucket_queue_hh
+
+#include <cstring>
+#include <vector>
+#include "solver_types.hh"
+
+#include "minisat/mtl/IntMap.h"
+
+using std::vector;
+using Minisat::IntMap;
+
+namespace Qute {
+
+/* Priority queue of variables by activity that only orders approximately:
+ * a variable's bucket is given by the exponent and the two leading mantissa
+ * bits of its (non-negative) activity, so variables in the same bucket differ
+ * by less than 19%. Within a bucket, the variable inserted last comes first.
+ * Buckets are doubly linked lists, so insertion, removal and moving a bumped
+ * variable are constant time, in place of the O(log n) sifting of a heap. */
+class ActivityBucketQueue {
+
+public:
+  ActivityBucketQueue(const IntMap<Variable, double>& activity);
+  void addVariable();
+  bool inQueue(Variable v) const;
+  bool empty();
+  Variable top() const;
+  void insert(Variable v);
+  void update(Variable v);
+  void remove(Variable v);
+  Variable removeTop();
+  void rebuild();
+  static uint32_t bucketOf(double activity);
+
+protected:
+  enum: uint32_t { nr_buckets = 1 << 13, not_queued = nr_buckets };
+
+  const IntMap<Variable, double>& activity;
+  vector<Variable> head; // first variable of each bucket, 0 if the bucket is empty
+  vector<Variable> next; // indexed by variable
+  vector<Variable> previous;
+  vector<uint32_t> bucket; // bucket of each variable, not_queued if it is not in the queue
+  uint32_t top_bucket; // all buckets above are empty
+
+};
+
+// Implementation of inline methods.
+
+inline ActivityBucketQueue::ActivityBucketQueue(const IntMap<Variable, double>& activity): activity(activity), head(nr_buckets, 0), next(1, 0), previous(1, 0), bucket(1, not_queued), top_bucket(0) {}
+
+inline void ActivityBucketQueue::addVariable() {
+  next.push_back(0);
+  previous.push_back(0);
+  bucket.push_back(not_queued);
+}
+
+inline uint32_t ActivityBucketQueue::bucketOf(double activity) {
+  // For non-negative doubles, the 11 exponent bits followed by the mantissa compare like the values.
+  uint64_t bits;
+  memcpy(&bits, &activity, sizeof(bits));
+  return static_cast<uint32_t>(bits >> 50);
+}
+
+inline bool ActivityBucketQueue::inQueue(Variable v) const {
+  return bucket[v] != not_queued;
+}
+
+inline bool ActivityBucketQueue::empty() {
+  while (top_bucket > 0 && head[top_bucket] == 0) {
+    top_bucket--;
+  }
+  return head[top_bucket] == 0;
+}
+
+inline Variable ActivityBucketQueue::top() const {
+  // Only valid right after empty() returned false.
+  return head[top_bucket];
+}
+
+inline void ActivityBucketQueue::insert(Variable v) {
+  uint32_t b = bucketOf(activity[v]);
+  bucket[v] = b;
+  previous[v] = 0;
+  next[v] = head[b];
+  if (head[b] != 0) {
+    previous[head[b]] = v;
+  }
+  head[b] = v;
+  if (b > top_bucket) {
+    top_bucket = b;
+  }
+}
+
+inline void ActivityBucketQueue::remove(Variable v) {
+  if (previous[v] != 0) {
+    next[previous[v]] = next[v];
+  } else {
+    head[bucket[v]] = next[v];
+  }
+  if (next[v] != 0) {
+    previous[next[v]] = previous[v];
+  }
+  bucket[v] = not_queued;
+}
+
+inline void ActivityBucketQueue::update(Variable v) {
+  // Like Heap::update, this inserts variables that are not in the queue.
+  if (!inQueue(v)) {
+    insert(v);
+  } else if (bucketOf(activity[v]) != bucket[v]) {
+    remove(v);
+    insert(v);
+  }
+}
+
+inline Variable ActivityBucketQueue::removeTop() {
+  Variable v = top();
+  remove(v);
+  return v;
+}
+
+inline void ActivityBucketQueue::rebuild() {
+  // Reinsert from the lowest bucket up, keeping the order within each bucket.
+  vector<Variable> queued;
+  for (uint32_t b = 0; b <= top_bucket; b++) {
+    vector<Variable> bucket_variables;
+    for (Variable v = head[b]; v != 0; v = next[v]) {
+      bucket_variables.push_back(v);
+    }
+    queued.insert(queued.end(), bucket_variables.rbegin(), bucket_variables.rend());
+    head[b] = 0;
+  }
+  top_bucket = 0;
+  for (Variable v: queued) {
+    insert(v);
+  }
+}
+
+}
+
+#endif
@@ -59,6 +59,7 @@ class RegionAllocator
     uint32_t wasted    () const      { return wasted_; }
 
     Ref      alloc     (int size);
+    void     reserve   (uint32_t min_cap) { capacity(min_cap); }
     void     free      (int size)    { wasted_ += size; }
 
     // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
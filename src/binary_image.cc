@@ -0,0 +1,189 @@
+#include "binary_image.hh"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Qute {
+
+static const uint32_t binary_image_magic = 0x42545551; // "QUTB"
+static const uint32_t binary_image_version = 1;
+
+static const uint32_t variable_auxiliary_flag = 1 << 8;
+static const uint32_t variable_numeric_flag = 1 << 9;
+
+static const string error_header = "qute error: ";
+
+static_assert(sizeof(Literal) == sizeof(uint32_t), "literals are stored as 32-bit words");
+
+BinaryImageWriter::BinaryImageWriter(PCNFContainer& pcnf): pcnf(pcnf), max_var_declared(0), num_clauses_declared(0), nr_constraints(0) {}
+
+void BinaryImageWriter::addVariable(string original_name, char variable_type, bool auxiliary) {
+  prefix.push_back(static_cast<uint8_t>(variable_type) | (auxiliary ? variable_auxiliary_flag : 0));
+  prefix.push_back(name_pool.size());
+  prefix.push_back(original_name.size());
+  name_pool += original_name;
+  pcnf.addVariable(original_name, variable_type, auxiliary);
+}
+
+void BinaryImageWriter::addVariable(Variable original_id, char variable_type, bool auxiliary) {
+  prefix.push_back(static_cast<uint8_t>(variable_type) | (auxiliary ? variable_auxiliary_flag : 0) | variable_numeric_flag);
+  prefix.push_back(original_id);
+  prefix.push_back(0);
+  pcnf.addVariable(original_id, variable_type, auxiliary);
+}
+
+CRef BinaryImageWriter::addConstraint(vector<Literal>& literals, ConstraintType constraint_type) {
+  // Record before forwarding, the solver reorders the literals in place.
+  constraints.push_back((literals.size() << 1) | constraint_type);
+  for (Literal l: literals) {
+    constraints.push_back(toInt(l));
+  }
+  nr_constraints++;
+  return pcnf.addConstraint(literals, constraint_type);
+}
+
+void BinaryImageWriter::addDependency(Variable of, Variable on) {
+  dependencies.push_back(of);
+  dependencies.push_back(on);
+  pcnf.addDependency(of, on);
+}
+
+void BinaryImageWriter::notifyMaxVarDeclaration(Variable max_var) {
+  max_var_declared = max_var;
+  pcnf.notifyMaxVarDeclaration(max_var);
+}
+
+void BinaryImageWriter::notifyNumClausesDeclaration(uint32_t num_clauses) {
+  num_clauses_declared = num_clauses;
+  pcnf.notifyNumClausesDeclaration(num_clauses);
+}
+
+bool BinaryImageWriter::write(const string& filename, bool use_model_generation) {
+  std::ofstream ofs(filename, std::ios::binary);
+  if (!ofs.is_open()) {
+    return false;
+  }
+  uint32_t name_pool_words = (name_pool.size() + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+  BinaryImageHeader header = {binary_image_magic, binary_image_version, use_model_generation, max_var_declared, num_clauses_declared,
+                              static_cast<uint32_t>(prefix.size() / 3), name_pool_words, static_cast<uint32_t>(dependencies.size() / 2),
+                              nr_constraints, static_cast<uint32_t>(constraints.size())};
+  name_pool.resize(name_pool_words * sizeof(uint32_t), '\0');
+  ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  ofs.write(reinterpret_cast<const char*>(prefix.data()), prefix.size() * sizeof(uint32_t));
+  ofs.write(name_pool.data(), name_pool.size());
+  ofs.write(reinterpret_cast<const char*>(dependencies.data()), dependencies.size() * sizeof(uint32_t));
+  ofs.write(reinterpret_cast<const char*>(constraints.data()), constraints.size() * sizeof(uint32_t));
+  return ofs.good();
+}
+
+bool isBinaryImage(const string& filename) {
+  std::ifstream ifs(filename, std::ios::binary);
+  uint32_t magic = 0;
+  ifs.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+  return ifs.good() && magic == binary_image_magic;
+}
+
+static void corrupt_image_error(const string& filename) {
+  std::cerr << error_header << "Corrupt binary image '" << filename << "'" << std::endl;
+  exit(1);
+}
+
+void readBinaryImage(const string& filename, PCNFContainer& pcnf, bool use_model_generation) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  struct stat file_status;
+  if (fd < 0 || fstat(fd, &file_status) != 0) {
+    std::cerr << error_header << "Cannot open binary image '" << filename << "'" << std::endl;
+    exit(1);
+  }
+  size_t file_size = file_status.st_size;
+  if (file_size < sizeof(BinaryImageHeader)) {
+    corrupt_image_error(filename);
+  }
+  void* mapping = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    std::cerr << error_header << "Cannot map binary image '" << filename << "'" << std::endl;
+    exit(1);
+  }
+  madvise(mapping, file_size, MADV_SEQUENTIAL);
+
+  BinaryImageHeader header;
+  std::memcpy(&header, mapping, sizeof(header));
+  if (header.magic != binary_image_magic || header.version != binary_image_version) {
+    corrupt_image_error(filename);
+  }
+  if (static_cast<bool>(header.use_model_generation) != use_model_generation) {
+    std::cerr << error_header << "Binary image '" << filename << "' was created with model generation "
+              << (header.use_model_generation ? "on" : "off") << ", the same setting must be used to load it" << std::endl;
+    exit(1);
+  }
+  uint64_t expected_words = 3 * (uint64_t)header.nr_variables + header.name_pool_words + 2 * (uint64_t)header.nr_dependencies + header.constraint_words;
+  if (file_size != sizeof(header) + expected_words * sizeof(uint32_t)) {
+    corrupt_image_error(filename);
+  }
+
+  const uint32_t* prefix = reinterpret_cast<const uint32_t*>(static_cast<const char*>(mapping) + sizeof(header));
+  const char* name_pool = reinterpret_cast<const char*>(prefix + 3 * header.nr_variables);
+  const uint32_t* dependencies = reinterpret_cast<const uint32_t*>(name_pool) + header.name_pool_words;
+  const uint32_t* constraints = dependencies + 2 * header.nr_dependencies;
+  const uint32_t* constraints_end = constraints + header.constraint_words;
+
+  if (header.max_var_declared) {
+    pcnf.notifyMaxVarDeclaration(header.max_var_declared);
+  }
+  if (header.num_clauses_declared) {
+    pcnf.notifyNumClausesDeclaration(header.num_clauses_declared);
+  }
+  for (uint32_t i = 0; i < header.nr_variables; i++) {
+    const uint32_t* record = prefix + 3 * i;
+    char variable_type = static_cast<char>(record[0] & 0xff);
+    bool auxiliary = record[0] & variable_auxiliary_flag;
+    if (record[0] & variable_numeric_flag) {
+      pcnf.addVariable(static_cast<Variable>(record[1]), variable_type, auxiliary);
+    } else {
+      if ((uint64_t)record[1] + record[2] > header.name_pool_words * sizeof(uint32_t)) {
+        corrupt_image_error(filename);
+      }
+      pcnf.addVariable(string(name_pool + record[1], record[2]), variable_type, auxiliary);
+    }
+  }
+  for (uint32_t i = 0; i < header.nr_dependencies; i++) {
+    Variable of = dependencies[2 * i];
+    Variable on = dependencies[2 * i + 1];
+    if (of < 1 || on < 1 || static_cast<uint32_t>(of) > header.nr_variables || static_cast<uint32_t>(on) > header.nr_variables) {
+      corrupt_image_error(filename);
+    }
+    pcnf.addDependency(of, on);
+  }
+  // Literals are stored exactly as in memory, so each constraint is copied over in one go.
+  vector<Literal> literals;
+  for (uint32_t i = 0; i < header.nr_constraints; i++) {
+    if (constraints >= constraints_end) {
+      corrupt_image_error(filename);
+    }
+    uint32_t size = *constraints >> 1;
+    ConstraintType constraint_type = static_cast<ConstraintType>(*constraints & 1);
+    constraints++;
+    if (size > static_cast<uint32_t>(constraints_end - constraints)) {
+      corrupt_image_error(filename);
+    }
+    literals.resize(size);
+    std::memcpy(literals.data(), constraints, size * sizeof(uint32_t));
+    constraints += size;
+    for (Literal l: literals) {
+      if (var(l) < 1 || static_cast<uint32_t>(var(l)) > header.nr_variables) {
+        corrupt_image_error(filename);
+      }
+    }
+    pcnf.addConstraint(literals, constraint_type);
+  }
+
+  munmap(mapping, file_size);
+}
+
+}
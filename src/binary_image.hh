@@ -0,0 +1,72 @@
+#ifndef binary_image_hh
+#define binary_image_hh
+
+#include <string>
+#include <vector>
+#include "pcnf_container.hh"
+#include "solver_types.hh"
+
+using std::string;
+using std::vector;
+
+namespace Qute {
+
+/* A binary image stores a formula as it was handed to a PCNFContainer by the
+ * parser, i.e. after the Tseitin transformation of QCIR input and with all
+ * names already resolved. Solving the same formula again from the image skips
+ * tokenizing and name lookups altogether.
+ *
+ * The image is a sequence of native-endian 32-bit words:
+ *   header (see BinaryImageHeader)
+ *   prefix: one (flags, name id or name offset, name length) triple per variable
+ *   name pool: the characters of all non-numeric names, padded to a word
+ *   dependencies: one (of, on) pair per dependency
+ *   constraints: for each constraint a word (size << 1 | constraint type),
+ *                followed by its literals, in the order they were added
+ */
+struct BinaryImageHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t use_model_generation;
+  uint32_t max_var_declared;
+  uint32_t num_clauses_declared;
+  uint32_t nr_variables;
+  uint32_t name_pool_words;
+  uint32_t nr_dependencies;
+  uint32_t nr_constraints;
+  uint32_t constraint_words;
+};
+
+/* Forwards everything to the wrapped container while recording it, so that the
+ * image can be written once parsing is done. */
+class BinaryImageWriter: public PCNFContainer {
+
+public:
+  BinaryImageWriter(PCNFContainer& pcnf);
+  // Methods required by PCNFContainer.
+  virtual void addVariable(string original_name, char variable_type, bool auxiliary);
+  virtual void addVariable(Variable original_id, char variable_type, bool auxiliary);
+  virtual CRef addConstraint(vector<Literal>& literals, ConstraintType constraint_type);
+  virtual void addDependency(Variable of, Variable on);
+  virtual void notifyMaxVarDeclaration(Variable max_var);
+  virtual void notifyNumClausesDeclaration(uint32_t num_clauses);
+
+  bool write(const string& filename, bool use_model_generation);
+
+protected:
+  PCNFContainer& pcnf;
+  uint32_t max_var_declared;
+  uint32_t num_clauses_declared;
+  vector<uint32_t> prefix;
+  string name_pool;
+  vector<uint32_t> dependencies;
+  vector<uint32_t> constraints;
+  uint32_t nr_constraints;
+};
+
+bool isBinaryImage(const string& filename);
+void readBinaryImage(const string& filename, PCNFContainer& pcnf, bool use_model_generation);
+
+}
+
+#endif
@@ -129,6 +129,13 @@ class ConstraintAllocator
     void moveTo(ConstraintAllocator& to){
         ra.moveTo(to.ra); }
 
+    // Make room for nr_constraints non-learnt constraints of the given average size.
+    void reserve(uint32_t nr_constraints, uint32_t average_size)
+    {
+        uint64_t words = (uint64_t)nr_constraints * constraintWord32Size(average_size, false, print_trace);
+        ra.reserve(words < (1u << 31) ? (uint32_t)words : (1u << 31));
+    }
+
     CRef alloc(const vector<Literal>& literals, bool learnt=false)
     {
         assert(sizeof(Literal) == sizeof(uint32_t));
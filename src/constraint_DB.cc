@@ -9,6 +9,18 @@ namespace Qute {
 
 ConstraintDB::ConstraintDB(QCDCL_solver& solver, bool print_trace, double constraint_activity_decay, uint32_t max_learnt_clauses, uint32_t max_learnt_terms, uint32_t learnt_clauses_increment, uint32_t learnt_terms_increment, double clause_removal_ratio, double term_removal_ratio, bool use_activity_threshold, double constraint_increment, uint32_t LBD_threshold): removal_ratio{clause_removal_ratio, term_removal_ratio}, solver(solver), print_trace(print_trace), constraints{ConstraintAllocator(print_trace), ConstraintAllocator(print_trace)}, constraint_inc{constraint_increment, constraint_increment}, constraint_activity_decay(constraint_activity_decay), learnts_max{max_learnt_clauses, max_learnt_terms}, learnts_increment{learnt_clauses_increment, learnt_terms_increment}, ca_to(nullptr), use_activity_threshold(use_activity_threshold), LBD_threshold(LBD_threshold) {}
 
+void ConstraintDB::notifyMaxVarDeclaration(Variable max_var) {
+  for (ConstraintType constraint_type: constraint_types) {
+    literal_occurrences[constraint_type].reserve(2 * max_var);
+  }
+}
+
+void ConstraintDB::notifyNumClausesDeclaration(uint32_t num_clauses) {
+  input_constraint_references[ConstraintType::clauses].reserve(num_clauses);
+  // Input clauses are mostly short, assume 3 literals on average for the initial arena.
+  constraints[ConstraintType::clauses].reserve(num_clauses, 3);
+}
+
 CRef ConstraintDB::addConstraint(vector<Literal>& literals, ConstraintType constraint_type, bool learnt, bool tainted) {
   CRef constraint_reference = constraints[constraint_type].alloc(literals, learnt);
   Constraint& constraint = getConstraint(constraint_reference, constraint_type);
@@ -77,6 +89,7 @@ void ConstraintDB::relocConstraintReferences(ConstraintType constraint_type) {
 }
 
 void ConstraintDB::relocAll(ConstraintType constraint_type) {
+  PROFILE_PHASE(solver, relocation);
   assert(ca_to == nullptr);
   ConstraintAllocator to(constraints[constraint_type].size() - constraints[constraint_type].wasted(), print_trace);
   ca_to = &to;
@@ -90,6 +103,7 @@ void ConstraintDB::relocAll(ConstraintType constraint_type) {
 }
 
 void ConstraintDB::cleanConstraints(ConstraintType constraint_type) {
+  PROFILE_PHASE(solver, constraint_cleaning);
   sort(learnt_constraint_references[constraint_type].begin(), learnt_constraint_references[constraint_type].end(), ConstraintCompare(constraints[constraint_type]));
   uint32_t to_remove =  learnt_constraint_references[constraint_type].size() * removal_ratio[constraint_type];
   uint32_t removed_counter = 0;
@@ -112,6 +126,7 @@ void ConstraintDB::cleanConstraints(ConstraintType constraint_type) {
 }
 
 void ConstraintDB::cleanTaintedConstraints(ConstraintType constraint_type, const vector<Literal>& antidote) {
+  PROFILE_PHASE(solver, constraint_cleaning);
   // discard the circuit output constraint (MUST BE LAST!)
   CRef output_ref = input_constraint_references[constraint_type].back();
   constraints[constraint_type][output_ref].mark();
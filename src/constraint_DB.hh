@@ -21,6 +21,8 @@ class ConstraintDB {
 
 public:
   ConstraintDB(QCDCL_solver& solver, bool print_trace, double constraint_activity_decay, uint32_t max_learnt_clauses, uint32_t max_learnt_terms, uint32_t learnt_clauses_increment, uint32_t learnt_terms_increment, double clause_removal_ratio, double term_removal_ratio, bool use_activity_threshold, double constraint_increment, uint32_t LBD_threshold);
+  void notifyMaxVarDeclaration(Variable max_var);
+  void notifyNumClausesDeclaration(uint32_t num_clauses);
   CRef addConstraint(vector<Literal>& literals, ConstraintType constraint_type, bool learnt, bool tainted);
   Constraint& getConstraint(CRef constraint_reference, ConstraintType constraint_type);
   vector<CRef>::const_iterator constraintReferencesBegin(ConstraintType constraint_type, bool learnt);
@@ -62,6 +64,7 @@ protected:
   vector<CRef> input_constraint_references[2];
   vector<CRef> learnt_constraint_references[2];
   unordered_map<Literal, vector<CRef>> literal_occurrences[2];
+  const vector<CRef> no_occurrences;
   double constraint_inc[2];
   double constraint_activity_decay;
   uint32_t learnts_max[2];
@@ -85,12 +88,16 @@ inline vector<CRef>::const_iterator ConstraintDB::constraintReferencesEnd(Constr
   return learnt ? learnt_constraint_references[constraint_type].cend(): input_constraint_references[constraint_type].cend();
 }
 
+/* Lookups do not insert into literal_occurrences, so that they may run
+ * concurrently (see DependencyManagerRRS::precomputeDepsRRS). */
 inline vector<CRef>::const_iterator ConstraintDB::literalOccurrencesBegin(Literal l, ConstraintType constraint_type) {
-  return literal_occurrences[constraint_type][l].cbegin();
+  auto it = literal_occurrences[constraint_type].find(l);
+  return it != literal_occurrences[constraint_type].end() ? it->second.cbegin() : no_occurrences.cbegin();
 }
 
 inline vector<CRef>::const_iterator ConstraintDB::literalOccurrencesEnd(Literal l, ConstraintType constraint_type) {
-  return literal_occurrences[constraint_type][l].cend();
+  auto it = literal_occurrences[constraint_type].find(l);
+  return it != literal_occurrences[constraint_type].end() ? it->second.cend() : no_occurrences.cend();
 }
 
 inline void ConstraintDB::bumpConstraintActivity(Constraint& constraint, ConstraintType constraint_type) {
@@ -47,7 +47,7 @@ bool DebugHelper::isUnassignedPrimary(Literal literal, ConstraintType constraint
 }
 
 bool DebugHelper::disablesConstraint(Literal literal, ConstraintType constraint_type) {
-  return solver.variable_data_store->isAssigned(var(literal)) && (solver.variable_data_store->assignment(var(literal)) == sign(literal)) == disablingPolarity(constraint_type);
+  return solver.variable_data_store->isTrue(disablingLiteral(literal, constraint_type));
 }
 
 }
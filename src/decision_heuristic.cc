@@ -6,10 +6,130 @@
 
 namespace Qute {
 
-DecisionHeuristic::DecisionHeuristic(QCDCL_solver& solver): solver(solver), phase_heuristic(PhaseHeuristicOption::INVJW), conflict_counter(0) {
+DecisionHeuristic::DecisionHeuristic(QCDCL_solver& solver): solver(solver), phase_heuristic(PhaseHeuristicOption::INVJW), conflict_counter(0), use_target_phases{false, false}, conflict_free_trail_size(0), target_assigned(0), best_assigned(0), rephase_interval(0), restarts_until_rephase(0), nr_rephases(0) {
   distribution = bernoulli_distribution(0.5);
 }
 
+void DecisionHeuristic::notifyStart() {
+  literal_scores.assign(2 * (solver.variable_data_store->lastVariable() + 1), LiteralScores{{0, 0}, {0, 0}});
+  for (ConstraintType constraint_type: constraint_types) {
+    for (auto it = solver.constraint_database->constraintReferencesBegin(constraint_type, false);
+         it != solver.constraint_database->constraintReferencesEnd(constraint_type, false);
+         ++it) {
+      updateLiteralScores(solver.constraint_database->getConstraint(*it, constraint_type), constraint_type, 1);
+    }
+  }
+}
+
+void DecisionHeuristic::notifyInputConstraintAdded(Constraint& c, ConstraintType constraint_type) {
+  // Constraints added before the start of search are counted by notifyStart.
+  if (literal_scores.empty()) {
+    return;
+  }
+  // Constraints added during search may contain fresh variables.
+  literal_scores.resize(2 * (solver.variable_data_store->lastVariable() + 1), LiteralScores{{0, 0}, {0, 0}});
+  updateLiteralScores(c, constraint_type, 1);
+}
+
+void DecisionHeuristic::notifyInputConstraintRemoved(Constraint& c, ConstraintType constraint_type) {
+  if (!literal_scores.empty()) {
+    updateLiteralScores(c, constraint_type, -1);
+  }
+}
+
+void DecisionHeuristic::setTargetPhases(bool existential, bool universal, uint32_t rephase_interval) {
+  use_target_phases[false] = existential;
+  use_target_phases[true] = universal;
+  this->rephase_interval = rephase_interval;
+  restarts_until_rephase = rephase_interval;
+}
+
+bool DecisionHeuristic::decisionPhase(Variable v, bool no_phase_saving) {
+  // Called right before a decision, when the trail is propagated without a conflict.
+  conflict_free_trail_size = static_cast<uint32_t>(solver.variable_data_store->trailSize());
+  if (use_target_phases[solver.variable_data_store->varType(v)] && v <= target_phase.size() && target_phase[v - 1] != l_Undef) {
+    return target_phase[v - 1];
+  }
+  if (no_phase_saving || saved_phase[v - 1] == l_Undef) {
+    saved_phase[v - 1] = phaseHeuristic(v);
+  }
+  return saved_phase[v - 1];
+}
+
+void DecisionHeuristic::updateTargetPhases() {
+  /* Called before backtracking. The part of the trail that was there at the
+   * last decision is conflict-free, everything after it may not be. */
+  if (!use_target_phases[false] && !use_target_phases[true]) {
+    return;
+  }
+  if (conflict_free_trail_size > target_assigned || conflict_free_trail_size > best_assigned) {
+    target_phase.resize(saved_phase.size(), l_Undef);
+    best_phase.resize(saved_phase.size(), l_Undef);
+    bool update_target = conflict_free_trail_size > target_assigned;
+    bool update_best = conflict_free_trail_size > best_assigned;
+    uint32_t i = 0;
+    for (TrailIterator it = solver.variable_data_store->trailBegin(); i < conflict_free_trail_size; ++it, ++i) {
+      Literal l = *it;
+      if (update_target) {
+        target_phase[var(l) - 1] = sign(l);
+      }
+      if (update_best) {
+        best_phase[var(l) - 1] = sign(l);
+      }
+    }
+    target_assigned = max(target_assigned, conflict_free_trail_size);
+    best_assigned = max(best_assigned, conflict_free_trail_size);
+  }
+  conflict_free_trail_size = 0;
+}
+
+void DecisionHeuristic::notifyRestart() {
+  if (rephase_interval == 0 || (!use_target_phases[false] && !use_target_phases[true])) {
+    return;
+  }
+  if (--restarts_until_rephase == 0) {
+    rephase();
+    nr_rephases++;
+    // Rephase at arithmetically growing distances.
+    restarts_until_rephase = rephase_interval * (nr_rephases + 1);
+  }
+}
+
+void DecisionHeuristic::rephase() {
+  /* Cycle through resetting the saved phases to the best phases, the phases of the
+   * static phase heuristic, the best phases, the inverted static phases, the best
+   * phases and random phases. Target phases are forgotten. */
+  enum {BEST, ORIGINAL, INVERTED, RANDOM};
+  static const int schedule[] = {BEST, ORIGINAL, BEST, INVERTED, BEST, RANDOM};
+  int kind = schedule[nr_rephases % (sizeof(schedule) / sizeof(schedule[0]))];
+  for (Variable v = 1; v <= saved_phase.size(); v++) {
+    if (!use_target_phases[solver.variable_data_store->varType(v)]) {
+      continue;
+    }
+    switch (kind) {
+      case BEST:
+        if (v <= best_phase.size() && best_phase[v - 1] != l_Undef) {
+          saved_phase[v - 1] = best_phase[v - 1];
+        }
+        break;
+      case ORIGINAL:
+        saved_phase[v - 1] = l_Undef;
+        break;
+      case INVERTED:
+        saved_phase[v - 1] = !phaseHeuristic(v);
+        break;
+      case RANDOM:
+        saved_phase[v - 1] = randomPhase();
+        break;
+    }
+  }
+  if (kind == BEST) {
+    best_assigned = 0;
+  }
+  fill(target_phase.begin(), target_phase.end(), l_Undef);
+  target_assigned = 0;
+}
+
 bool DecisionHeuristic::phaseHeuristic(Variable v) {
   switch (phase_heuristic)
   {
@@ -111,17 +231,6 @@ inline bool DecisionHeuristic::watcherPhaseHeuristic(Variable v) {
   return solver.propagator->phaseAdvice(v);
 }
 
-double DecisionHeuristic::invJeroslowWangScore(Literal l, ConstraintType constraint_type) {
-  double score = 0;
-  for (vector<CRef>::const_iterator it = solver.constraint_database->literalOccurrencesBegin(l, constraint_type);
-       it != solver.constraint_database->literalOccurrencesEnd(l, constraint_type);
-       ++it) {
-    Constraint& constraint = solver.constraint_database->getConstraint(*it, constraint_type);
-    score += (1 << constraint.size());
-  }
-  return score;
-}
-
 bool DecisionHeuristic::qtypeDecHeur(Variable v) {
   /* We want to "guess" a polarity so that we do not have to undo this
      assignment later. For a universal variable, that means we want to get to
@@ -137,8 +246,12 @@ bool DecisionHeuristic::qtypeDecHeur(Variable v) {
   }
 }
 
-int DecisionHeuristic::nrLiteralOccurrences(Literal l, ConstraintType constraint_type) {
-  return solver.constraint_database->literalOccurrencesEnd(l, constraint_type) - solver.constraint_database->literalOccurrencesBegin(l, constraint_type);
+void DecisionHeuristic::updateLiteralScores(Constraint& c, ConstraintType constraint_type, int sign) {
+  double inv_JW_weight = sign * (1 << c.size());
+  for (Literal l: c) {
+    literal_scores[toInt(l)].inv_JW[constraint_type] += inv_JW_weight;
+    literal_scores[toInt(l)].nr_occurrences[constraint_type] += sign;
+  }
 }
 
 }
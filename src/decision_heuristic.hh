@@ -31,7 +31,8 @@ public:
   DecisionHeuristic(QCDCL_solver& solver);
   virtual ~DecisionHeuristic() {}
   virtual void addVariable(bool auxiliary) = 0;
-  virtual void notifyStart() = 0;
+  virtual void notifyMaxVarDeclaration(Variable max_var);
+  virtual void notifyStart();
   virtual void notifyAssigned(Literal l) = 0;
   virtual void notifyUnassigned(Literal l) = 0;
   virtual void notifyEligible(Variable v) = 0;
@@ -39,11 +40,16 @@ public:
   virtual void notifyBacktrack(uint32_t decision_level_before) = 0;
   virtual Literal getDecisionLiteral() = 0;
   virtual void notifyConflict(ConstraintType constraint_type);
+  virtual void notifyRestart();
+  virtual void notifyInputConstraintAdded(Constraint& c, ConstraintType constraint_type);
+  virtual void notifyInputConstraintRemoved(Constraint& c, ConstraintType constraint_type);
 
   enum class PhaseHeuristicOption: int8_t {INVJW, QTYPE, WATCHER, RANDOM, PHFALSE, PHTRUE};
 
   void setPhaseHeuristic(PhaseHeuristicOption heuristic);
+  void setTargetPhases(bool existential, bool universal, uint32_t rephase_interval);
   bool phaseHeuristic(Variable v);
+  virtual void updateTargetPhases();
 
 protected:
   //bool svmPhase(Variable v);
@@ -53,6 +59,9 @@ protected:
   double invJeroslowWangScore(Literal l, ConstraintType constraint_type);
   bool qtypeDecHeur(Variable v);
   int nrLiteralOccurrences(Literal l, ConstraintType constraint_type);
+  void updateLiteralScores(Constraint& c, ConstraintType constraint_type, int sign);
+  bool decisionPhase(Variable v, bool no_phase_saving);
+  void rephase();
 
   QCDCL_solver& solver;
   random_device generator;
@@ -65,12 +74,47 @@ protected:
   map<Variable,uint32_t> last_update;*/
   uint32_t conflict_counter;
 
+  /* Scores of each literal over the input constraints, indexed by toInt(l).
+   * Computed at the start of search and kept up to date when input
+   * constraints are added or removed during search. */
+  struct LiteralScores {
+    double inv_JW[2];
+    int nr_occurrences[2];
+  };
+  vector<LiteralScores> literal_scores;
+
+  /* Target phases are the assignment of the longest trail without a conflict
+   * since the last rephase, best phases that of the longest such trail since
+   * the saved phases were last set to them. Both are only tracked if target
+   * phases are used for some quantifier type. */
+  bool use_target_phases[2];
+  vector<lbool> target_phase;
+  vector<lbool> best_phase;
+  uint32_t conflict_free_trail_size;
+  uint32_t target_assigned;
+  uint32_t best_assigned;
+  uint32_t rephase_interval;
+  uint32_t restarts_until_rephase;
+  uint32_t nr_rephases;
+
 };
 
+inline void DecisionHeuristic::notifyMaxVarDeclaration(Variable max_var) {
+  saved_phase.reserve(max_var);
+}
+
 inline void DecisionHeuristic::setPhaseHeuristic(PhaseHeuristicOption heuristic) {
   phase_heuristic = heuristic;
 }
 
+inline double DecisionHeuristic::invJeroslowWangScore(Literal l, ConstraintType constraint_type) {
+  return literal_scores[toInt(l)].inv_JW[constraint_type];
+}
+
+inline int DecisionHeuristic::nrLiteralOccurrences(Literal l, ConstraintType constraint_type) {
+  return literal_scores[toInt(l)].nr_occurrences[constraint_type];
+}
+
 inline bool DecisionHeuristic::randomPhase() {
   return distribution(generator);
 }
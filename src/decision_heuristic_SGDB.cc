@@ -2,11 +2,17 @@
 
 namespace Qute {
 
-DecisionHeuristicSGDB::DecisionHeuristicSGDB(QCDCL_solver& solver, bool no_phase_saving, double initial_learning_rate, double learning_rate_decay, double minimum_learning_rate, double lambda_factor): DecisionHeuristic(solver), no_phase_saving(no_phase_saving), bias(0), learning_rate(initial_learning_rate), learning_rate_decay(learning_rate_decay), minimum_learning_rate(minimum_learning_rate), lambda_factor(lambda_factor), lambda(initial_learning_rate*lambda_factor), universal_queue(CompareVariables(true, coefficient)), existential_queue(CompareVariables(false, coefficient)), current_activation(0) {}
+DecisionHeuristicSGDB::DecisionHeuristicSGDB(QCDCL_solver& solver, bool no_phase_saving, double initial_learning_rate, double learning_rate_decay, double minimum_learning_rate, double lambda_factor): DecisionHeuristic(solver), no_phase_saving(no_phase_saving), bias(0), learning_rate(initial_learning_rate), learning_rate_decay(learning_rate_decay), minimum_learning_rate(minimum_learning_rate), lambda_factor(lambda_factor), lambda(initial_learning_rate*lambda_factor), universal_queue(CompareVariables(true, coefficient)), existential_queue(CompareVariables(false, coefficient)), current_activation(0) {
+  updateDecayTable();
+}
 
 void DecisionHeuristicSGDB::notifyUnassigned(Literal l) {
   auto v = var(l);
   current_activation -= coefficient[v];
+  if (solver.variable_data_store->trailIsEmpty()) {
+    // Discard the rounding errors accumulated by the incremental updates.
+    current_activation = bias;
+  }
   auto& variable_record = variable_data[v-1];
   if (!variable_record.is_auxiliary) {
     Variable watcher = solver.dependency_manager->watcher(v);
@@ -24,22 +30,19 @@ void DecisionHeuristicSGDB::notifyUnassigned(Literal l) {
 }
 
 void DecisionHeuristicSGDB::notifyLearned(Constraint& c, ConstraintType constraint_type, vector<Literal>& conflict_side_literals) {
-  double activation = bias;
   updateParameters();
+  conflict_characteristic.clear();
+  characteristic_coefficients.clear();
   for (auto& l: c) {
     auto v = var(l);
     if (solver.variable_data_store->isAssigned(v)) {
-      lazyRegularize(v);
-      activation += coefficient[v];
-      assigned_conflict_characteristic[v-1] = 1;
+      addToConflictCharacteristic(v);
     }
   }
   for (auto& l: conflict_side_literals) {
-    auto v = var(l);
-    lazyRegularize(v);
-    activation += coefficient[v];
-    assigned_conflict_characteristic[v-1] = 1;
+    addToConflictCharacteristic(var(l));
   }
+  double activation = bias + sum(characteristic_coefficients.data(), characteristic_coefficients.size());
 
   double prediction = sigmoid(activation); // Is this assignment a conflict (or a solution)?
   double sign = constraint_type ? 1 : -1;
@@ -50,19 +53,27 @@ void DecisionHeuristicSGDB::notifyLearned(Constraint& c, ConstraintType constrai
     //cout << (constraint_type ? "Term" : "Clause") << "\n";
   } */
   // cout << "Error gradient: " << error_gradient << "\n";
+  double old_bias = bias;
   bias = bias * (1 - learning_rate*lambda/2) - learning_rate/2*(error_gradient);
-  current_activation = bias;
-  for (Variable v = 1; v <= solver.variable_data_store->lastVariable(); v++) {
-    if (assigned_conflict_characteristic[v-1] == 1) {
-      coefficient[v] *=  1 - learning_rate*lambda/2;
-      coefficient[v] -= learning_rate/2 * error_gradient;
-      bool variable_type = solver.variable_data_store->varType(v);
-      if (!variable_data[v-1].is_auxiliary) {
-        if (variable_type) {
-          universal_queue.update(v);
-        } else {
-          existential_queue.update(v);
-        }
+  current_activation += bias - old_bias;
+  /* Only coefficients in the conflict characteristic change, all others are
+     regularized lazily when they are next touched. */
+  double scale = 1 - learning_rate*lambda/2;
+  double step = learning_rate/2 * error_gradient;
+  double* updated_coefficients = characteristic_coefficients.data();
+  for (size_t i = 0; i < characteristic_coefficients.size(); i++) {
+    updated_coefficients[i] = updated_coefficients[i] * scale - step;
+  }
+  // Writing back goes through the queues, which must see one change at a time.
+  for (size_t i = 0; i < conflict_characteristic.size(); i++) {
+    Variable v = conflict_characteristic[i];
+    coefficient[v] = updated_coefficients[i];
+    bool variable_type = solver.variable_data_store->varType(v);
+    if (!variable_data[v-1].is_auxiliary) {
+      if (variable_type) {
+        universal_queue.update(v);
+      } else {
+        existential_queue.update(v);
       }
     }
     assigned_conflict_characteristic[v-1] = 0;
@@ -89,10 +100,7 @@ Literal DecisionHeuristicSGDB::getDecisionLiteral() {
   assert(!variable_data[candidate-1].is_auxiliary);
   assert(solver.dependency_manager->isDecisionCandidate(candidate));
   // cout << "Candidate coefficient: " << coefficient[candidate] << "\n";
-  if (no_phase_saving || saved_phase[candidate - 1] == l_Undef) {
-    saved_phase[candidate - 1] = phaseHeuristic(candidate);
-  }
-  return mkLiteral(candidate, saved_phase[candidate - 1]);
+  return mkLiteral(candidate, decisionPhase(candidate, no_phase_saving));
 }
 
 }
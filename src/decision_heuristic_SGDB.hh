@@ -11,11 +11,9 @@
 #include "qcdcl.hh"
 
 #include "minisat/mtl/Heap.h"
-#include "minisat/mtl/IntMap.h"
 
 using std::find;
 using Minisat::Heap;
-using Minisat::IntMap;
 
 namespace Qute {
 
@@ -24,6 +22,7 @@ class DecisionHeuristicSGDB: public DecisionHeuristic {
 public:
   DecisionHeuristicSGDB(QCDCL_solver& solver, bool no_phase_saving, double initial_learning_rate, double learning_rate_decay, double minimum_learning_rate, double lambda_factor);
   virtual void addVariable(bool auxiliary);
+  virtual void notifyMaxVarDeclaration(Variable max_var);
   virtual void notifyStart();
   virtual void notifyAssigned(Literal l);
   virtual void notifyUnassigned(Literal l);
@@ -38,6 +37,10 @@ protected:
   double sigmoid(double x);
   void updateParameters();
   void lazyRegularize(Variable v);
+  double decay(uint32_t nr_conflicts);
+  void updateDecayTable();
+  void addToConflictCharacteristic(Variable v);
+  static double sum(const double* values, size_t n);
   bool assignmentPredictedConflict();
   bool lessThan(bool variable_type, double first_coefficient, double second_coefficient);
 
@@ -51,6 +54,12 @@ protected:
   double lambda;
   uint32_t backtrack_decision_level_before;
   vector<short> assigned_conflict_characteristic;
+  vector<Variable> conflict_characteristic; // variables marked in assigned_conflict_characteristic
+  /* Coefficients of the conflict characteristic, kept contiguous so that the
+     arithmetic of an update is a simple loop the compiler can vectorize. */
+  vector<double> characteristic_coefficients;
+  // decay_table[i] is the per-conflict regularization factor raised to the power of 2^i.
+  double decay_table[32];
   // uint32_t output_last = 0;
 
   struct VariableData {
@@ -59,11 +68,11 @@ protected:
     VariableData(bool is_auxiliary): is_auxiliary(is_auxiliary), regularized_last(0) {}
   };
 
-  IntMap<Variable, double> coefficient;
+  vector<double> coefficient; // indexed by variable, the entry for 0 is unused
 
   struct CompareVariables
   {
-    CompareVariables(bool variable_type, const IntMap<Variable, double>&  coefficient): variable_type(variable_type), coefficient(coefficient) {};
+    CompareVariables(bool variable_type, const vector<double>&  coefficient): variable_type(variable_type), coefficient(coefficient) {};
     bool operator()(const Variable first, const Variable second) const {
       return (variable_type && (coefficient[first] > coefficient[second])) || (!variable_type && (coefficient[first] < coefficient[second]));
       /* For universal variables (variable_type == true), this amounts to the standard order < on coefficients.
@@ -72,27 +81,34 @@ protected:
          a solution). */
     }
     bool variable_type;
-    const IntMap<Variable, double>&  coefficient;
+    const vector<double>&  coefficient;
   };
 
   vector<VariableData> variable_data;
   Heap<Variable,CompareVariables> universal_queue, existential_queue;
 
   //TrailIterator current_trail_position;
-  double current_activation;
+  double current_activation; // bias plus the coefficients of all assigned variables
 
   // For debugging
   double maxCoeff(ConstraintType constraint_type);
 
 };
 
+inline void DecisionHeuristicSGDB::notifyMaxVarDeclaration(Variable max_var) {
+  DecisionHeuristic::notifyMaxVarDeclaration(max_var);
+  variable_data.reserve(max_var);
+  coefficient.reserve(max_var + 1);
+}
+
 inline void DecisionHeuristicSGDB::addVariable(bool auxiliary) {
   variable_data.emplace_back(auxiliary);
   saved_phase.push_back(l_Undef);
-  coefficient.insert(solver.variable_data_store->lastVariable(), 0);
+  coefficient.resize(solver.variable_data_store->lastVariable() + 1, 0);
 }
 
 inline void DecisionHeuristicSGDB::notifyStart() {
+  DecisionHeuristic::notifyStart();
   assigned_conflict_characteristic.resize(solver.variable_data_store->lastVariable());
   fill(assigned_conflict_characteristic.begin(), assigned_conflict_characteristic.end(), 0);
   for (Variable v = 1; v <= solver.variable_data_store->lastVariable(); v++) {
@@ -159,13 +175,32 @@ inline void DecisionHeuristicSGDB::updateParameters() {
   if (learning_rate > minimum_learning_rate) {
     learning_rate = learning_rate - learning_rate_decay;
     lambda = learning_rate * lambda_factor;
+    updateDecayTable();
+  }
+}
+
+inline void DecisionHeuristicSGDB::updateDecayTable() {
+  decay_table[0] = 1 - learning_rate * lambda/2;
+  for (uint32_t i = 1; i < 32; i++) {
+    decay_table[i] = decay_table[i-1] * decay_table[i-1];
   }
 }
 
+inline double DecisionHeuristicSGDB::decay(uint32_t nr_conflicts) {
+  // Replaces pow(1 - learning_rate * lambda/2, nr_conflicts) by one multiplication per set bit.
+  double factor = 1;
+  for (uint32_t i = 0; nr_conflicts; i++, nr_conflicts >>= 1) {
+    if (nr_conflicts & 1) {
+      factor *= decay_table[i];
+    }
+  }
+  return factor;
+}
+
 inline void DecisionHeuristicSGDB::lazyRegularize(Variable v) {
   auto& variable_record = variable_data[v-1];
   if (conflict_counter > variable_record.regularized_last) {
-    coefficient[v] *= pow(1-learning_rate * lambda/2, conflict_counter - variable_record.regularized_last);
+    coefficient[v] *= decay(conflict_counter - variable_record.regularized_last);
     auto variable_type = solver.variable_data_store->varType(v);
     if (!variable_data[v-1].is_auxiliary) {
       if (variable_type) {
@@ -178,6 +213,36 @@ inline void DecisionHeuristicSGDB::lazyRegularize(Variable v) {
   variable_record.regularized_last = conflict_counter;
 }
 
+inline void DecisionHeuristicSGDB::addToConflictCharacteristic(Variable v) {
+  if (!assigned_conflict_characteristic[v-1]) {
+    assigned_conflict_characteristic[v-1] = 1;
+    conflict_characteristic.push_back(v);
+    if (solver.variable_data_store->isAssigned(v)) {
+      // Added back to the running activation once the coefficient is updated.
+      current_activation -= coefficient[v];
+    }
+    // Regularized here, but only written back together with the gradient step.
+    auto& variable_record = variable_data[v-1];
+    characteristic_coefficients.push_back(coefficient[v] * decay(conflict_counter - variable_record.regularized_last));
+    variable_record.regularized_last = conflict_counter;
+  }
+}
+
+inline double DecisionHeuristicSGDB::sum(const double* values, size_t n) {
+  // Independent partial sums let the loop be vectorized without reassociating floating point additions.
+  double partial[4] = {0, 0, 0, 0};
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    for (size_t j = 0; j < 4; j++) {
+      partial[j] += values[i + j];
+    }
+  }
+  for (; i < n; i++) {
+    partial[0] += values[i];
+  }
+  return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+}
+
 inline double DecisionHeuristicSGDB::maxCoeff(ConstraintType constraint_type) {
   Variable max_variable = 0;
   double max_coeff;
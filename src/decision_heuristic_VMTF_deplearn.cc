@@ -2,7 +2,13 @@
 
 namespace Qute {
 
-DecisionHeuristicVMTFdeplearn::DecisionHeuristicVMTFdeplearn(QCDCL_solver& solver, bool no_phase_saving): DecisionHeuristic(solver), list_head(0), next_search(0), timestamp(0), overflow_queue(CompareVariables(decision_list)), no_phase_saving(no_phase_saving) {}
+DecisionHeuristicVMTFdeplearn::DecisionHeuristicVMTFdeplearn(QCDCL_solver& solver, bool no_phase_saving, bool bump_conflict_side): DecisionHeuristic(solver), list_head(0), list_size(0), next_search(0), timestamp(0), no_phase_saving(no_phase_saving), bump_conflict_side(bump_conflict_side) {}
+
+void DecisionHeuristicVMTFdeplearn::notifyMaxVarDeclaration(Variable max_var) {
+  DecisionHeuristic::notifyMaxVarDeclaration(max_var);
+  decision_list.reserve(max_var);
+  is_auxiliary.reserve(max_var);
+}
 
 void DecisionHeuristicVMTFdeplearn::addVariable(bool auxiliary) {
   saved_phase.push_back(l_Undef);
@@ -10,6 +16,7 @@ void DecisionHeuristicVMTFdeplearn::addVariable(bool auxiliary) {
   if (decision_list.empty()) {
     decision_list.emplace_back();
     list_head = next_search = 1;
+    list_size = 1;
   } else {
     /* Add new variable at the end of the list if it's not an auxiliary variable.
      * Each auxiliary is contained in a singleton list. */
@@ -24,6 +31,7 @@ void DecisionHeuristicVMTFdeplearn::addVariable(bool auxiliary) {
       decision_list[old_last - 1].next = new_var;
       // move the head so that later variables get higher timestamps
       list_head = next_search = new_var;
+      list_size++;
     } else {
       new_entry.next = new_var;
       new_entry.prev = new_var;
@@ -48,54 +56,60 @@ void DecisionHeuristicVMTFdeplearn::notifyUnassigned(Literal l) {
 }
 
 void DecisionHeuristicVMTFdeplearn::notifyLearned(Constraint& c, ConstraintType constraint_type, vector<Literal>& conflict_side_literals) {
-  // Bump every assigned variable in the learned constraint.
+  // Bump every assigned variable in the learned constraint, and optionally the variables resolved on.
+  variables_to_bump.clear();
   for (Literal l: c) {
-    Variable v = var(l);
-    if (solver.variable_data_store->isAssigned(v)) {
-      moveToFront(v);
+    collectForBumping(var(l));
+  }
+  if (bump_conflict_side) {
+    for (Literal l: conflict_side_literals) {
+      collectForBumping(var(l));
     }
   }
+  if (timestamp > ((uint32_t)-1) - variables_to_bump.size()) {
+    resetTimestamps();
+  }
+  /* Move variables to the front in the order of their timestamps, so that
+   * bumped variables keep their relative order. */
+  CompareVariables compare(decision_list);
+  sort(variables_to_bump.begin(), variables_to_bump.end(), compare);
+  variables_to_bump.erase(unique(variables_to_bump.begin(), variables_to_bump.end()), variables_to_bump.end());
+  for (Variable v: variables_to_bump) {
+    moveToFront(v);
+  }
 }
 
 void DecisionHeuristicVMTFdeplearn::notifyBacktrack(uint32_t decision_level_before) {
   backtrack_decision_level_before = decision_level_before;
-  clearOverflowQueue();
 }
 
 Literal DecisionHeuristicVMTFdeplearn::getDecisionLiteral() {
-  Variable candidate = 0;
-  // First, check the overflow queue for an unassigned variable.
-  while (!overflow_queue.empty() && solver.variable_data_store->isAssigned(overflow_queue.top())) {
-    overflow_queue.pop();
-  }
-  if (!overflow_queue.empty()) {
-    candidate = overflow_queue.top();
-    overflow_queue.pop();
-  } else {
-    // If no suitable variable was found in the overflow queue, search in the linked list, starting from next_search.
-    while (!solver.dependency_manager->isDecisionCandidate(next_search) && decision_list[next_search - 1].next != list_head) {
-      next_search = decision_list[next_search - 1].next;
-    }
-    candidate = next_search;
+  // Search the list from next_search, all variables before it are no decision candidates.
+  while (!solver.dependency_manager->isDecisionCandidate(next_search) && decision_list[next_search - 1].next != list_head) {
+    next_search = decision_list[next_search - 1].next;
   }
+  Variable candidate = next_search;
   assert(candidate != 0);
   assert(!is_auxiliary[candidate - 1]);
   assert(solver.dependency_manager->isDecisionCandidate(candidate));
   assert(decision_list[candidate - 1].timestamp == maxTimestampEligible());
-  if (no_phase_saving || saved_phase[candidate - 1] == l_Undef) {
-    saved_phase[candidate - 1] = phaseHeuristic(candidate);
-  }
-  return mkLiteral(candidate, saved_phase[candidate - 1]);
+  return mkLiteral(candidate, decisionPhase(candidate, no_phase_saving));
 }
 
 void DecisionHeuristicVMTFdeplearn::resetTimestamps() {
-  /* Assign timestamps in ascending order, starting from the back of the
-     list. */
-  timestamp = 0;
+  /* Timestamps increase strictly from the back of the list to its head, so
+   * the k-th variable from the back has a timestamp of at least k. Assign
+   * every variable its position, walking from the head until the
+   * variables are already numbered that way. */
+  timestamp = list_size - 1;
+  uint32_t position = timestamp;
   Variable list_ptr = list_head;
   do {
-    list_ptr = decision_list[list_ptr - 1].prev;
-    decision_list[list_ptr - 1].timestamp = timestamp++;
+    if (decision_list[list_ptr - 1].timestamp == position) {
+      break;
+    }
+    decision_list[list_ptr - 1].timestamp = position--;
+    list_ptr = decision_list[list_ptr - 1].next;
   } while (list_ptr != list_head);
 }
 
@@ -108,10 +122,7 @@ void DecisionHeuristicVMTFdeplearn::moveToFront(Variable variable) {
     return;
   }
 
-  /* Increase timestamp value */
-  if (timestamp == ((uint32_t)-1)) {
-    resetTimestamps();
-  }
+  // notifyLearned makes sure there is room for the timestamps of all bumped variables.
   decision_list[variable - 1].timestamp = ++timestamp;
 
   /* Detach variable from list */
@@ -7,11 +7,9 @@
 #include "qcdcl.hh"
 
 #include <vector>
-#include <queue>
 #include <random>
 
 using std::vector;
-using std::priority_queue;
 using std::random_device;
 using std::bernoulli_distribution;
 
@@ -20,9 +18,10 @@ namespace Qute {
 class DecisionHeuristicVMTFdeplearn: public DecisionHeuristic {
 
 public:
-  DecisionHeuristicVMTFdeplearn(QCDCL_solver& solver, bool no_phase_saving);
+  DecisionHeuristicVMTFdeplearn(QCDCL_solver& solver, bool no_phase_saving, bool bump_conflict_side = false);
 
   virtual void addVariable(bool auxiliary);
+  virtual void notifyMaxVarDeclaration(Variable max_var);
   virtual void notifyStart();
   virtual void notifyAssigned(Literal l);
   virtual void notifyEligible(Variable v);
@@ -34,7 +33,7 @@ public:
 protected:
   void resetTimestamps();
   void moveToFront(Variable variable);
-  void clearOverflowQueue();
+  void collectForBumping(Variable variable);
   uint32_t maxTimestampEligible();
   bool checkOrder();
 
@@ -56,20 +55,23 @@ protected:
   };
 
   Variable list_head;
+  Variable list_size;
   Variable next_search;
   uint32_t timestamp;
   vector<ListEntry> decision_list;
-  priority_queue<Variable, vector<Variable>, CompareVariables> overflow_queue;
   uint32_t backtrack_decision_level_before;
 
   bool no_phase_saving;
+  bool bump_conflict_side;
   vector<bool> is_auxiliary;
+  vector<Variable> variables_to_bump;
 
 };
 
 // Implementation of inline methods.
 
 inline void DecisionHeuristicVMTFdeplearn::notifyStart() {
+  DecisionHeuristic::notifyStart();
   Variable list_ptr = list_head;
   if (list_head) {
     do {
@@ -84,20 +86,16 @@ inline void DecisionHeuristicVMTFdeplearn::notifyAssigned(Literal l) {
 }
 
 inline void DecisionHeuristicVMTFdeplearn::notifyEligible(Variable v) {
+  /* Moving next_search towards the head never skips a decision candidate, it
+   * only makes the next search start earlier. */
   if (decision_list[v - 1].timestamp > decision_list[next_search - 1].timestamp && !is_auxiliary[v - 1]) {
-    overflow_queue.push(v);
+    next_search = v;
   }
 }
 
-inline void DecisionHeuristicVMTFdeplearn::clearOverflowQueue() {
-  while (!overflow_queue.empty()) {
-    auto variable = overflow_queue.top();
-    auto watcher = solver.dependency_manager->watcher(variable);
-    if ((watcher == 0 || (solver.variable_data_store->isAssigned(watcher) && (solver.variable_data_store->varDecisionLevel(watcher) < backtrack_decision_level_before)) || solver.dependency_manager->isEligibleOOO(variable)) &&
-         (decision_list[variable - 1].timestamp > decision_list[next_search - 1].timestamp)) {
-      next_search = variable;
-    }
-    overflow_queue.pop();
+inline void DecisionHeuristicVMTFdeplearn::collectForBumping(Variable variable) {
+  if (solver.variable_data_store->isAssigned(variable) && !is_auxiliary[variable - 1]) {
+    variables_to_bump.push_back(variable);
   }
 }
 
@@ -9,6 +9,13 @@ namespace Qute {
 
 DecisionHeuristicVMTFprefix::DecisionHeuristicVMTFprefix(QCDCL_solver& solver, bool no_phase_saving): DecisionHeuristic(solver), last_variable(0), no_phase_saving(no_phase_saving) {}
 
+void DecisionHeuristicVMTFprefix::notifyMaxVarDeclaration(Variable max_var) {
+  DecisionHeuristic::notifyMaxVarDeclaration(max_var);
+  is_auxiliary.reserve(max_var);
+  decision_list.reserve(max_var);
+  variable_depth.reserve(max_var);
+}
+
 void DecisionHeuristicVMTFprefix::addVariable(bool auxiliary) {
   // TODO move the depth-computing logic into variable_data
   // make sure this is called afterwards
@@ -37,6 +44,7 @@ void DecisionHeuristicVMTFprefix::addVariable(bool auxiliary) {
 }
 
 void DecisionHeuristicVMTFprefix::notifyStart() {
+  DecisionHeuristic::notifyStart();
   active_block[false] = active_block[true] = vmtf_data_for_block.size() + 1;
   if (vmtf_data_for_block.size() > 0) { // At least one quantifier block.
     active_block[solver.variable_data_store->varType(1)] = 0;
@@ -186,10 +194,7 @@ Literal DecisionHeuristicVMTFprefix::getDecisionLiteral() {
     };
   }
 
-  if (no_phase_saving || saved_phase[candidate - 1] == l_Undef) {
-    saved_phase[candidate - 1] = phaseHeuristic(candidate);
-  }
-  return mkLiteral(candidate, saved_phase[candidate - 1]);
+  return mkLiteral(candidate, decisionPhase(candidate, no_phase_saving));
 }
 
 void DecisionHeuristicVMTFprefix::resetTimestamps() {
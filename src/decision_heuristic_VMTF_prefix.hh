@@ -14,6 +14,7 @@ class DecisionHeuristicVMTFprefix: public DecisionHeuristic {
 public:
   DecisionHeuristicVMTFprefix(QCDCL_solver& solver, bool no_phase_saving);
   virtual void addVariable(bool auxiliary);
+  virtual void notifyMaxVarDeclaration(Variable max_var);
   virtual void notifyStart();
   virtual void notifyAssigned(Literal l);
   virtual void notifyEligible(Variable v);
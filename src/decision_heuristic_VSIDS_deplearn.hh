@@ -1,6 +1,7 @@
 #ifndef decision_heuristic_vsids_deplearn_hh
 #define decision_heuristic_vsids_deplearn_hh
 
+#include "activity_bucket_queue.hh"
 #include "decision_heuristic.hh"
 #include "solver_types.hh"
 #include "constraint.hh"
@@ -20,8 +21,9 @@ namespace Qute {
 class DecisionHeuristicVSIDSdeplearn: public DecisionHeuristic {
 
 public:
-  DecisionHeuristicVSIDSdeplearn(QCDCL_solver& solver, bool no_phase_saving, double score_decay_factor, double score_increment, bool tiebreak_scores, bool use_secondary_occurrences_for_tiebreaking, bool prefer_fewer_occurrences);
+  DecisionHeuristicVSIDSdeplearn(QCDCL_solver& solver, bool no_phase_saving, double score_decay_factor, double score_increment, bool tiebreak_scores, bool use_secondary_occurrences_for_tiebreaking, bool prefer_fewer_occurrences, bool use_bucket_queue = false);
   virtual void addVariable(bool auxiliary);
+  virtual void notifyMaxVarDeclaration(Variable max_var);
   virtual void notifyStart();
   virtual void notifyAssigned(Literal l);
   virtual void notifyUnassigned(Literal l);
@@ -36,6 +38,12 @@ protected:
   void rescaleVariableScores();
   void decayVariableScores();
   Variable popFromVariableQueue();
+  // The queue operations dispatch to either the heap or the bucket queue.
+  bool inVariableQueue(Variable v);
+  void insertIntoVariableQueue(Variable v);
+  void updateVariableQueue(Variable v);
+  bool variableQueueEmpty();
+  Variable variableQueueTop();
   double getBestDecisionVariableScore();
   bool allCandidatesInQueue();
   vector<Variable> getVariablesWithTopScore();
@@ -70,6 +78,8 @@ protected:
   IntMap<Variable, int> nr_literal_occurrences;
   IntMap<Variable, double> variable_activity;
   Heap<Variable,CompareVariables> variable_queue;
+  bool use_bucket_queue;
+  ActivityBucketQueue bucket_queue;
 };
 
 // Implementation of inline methods
@@ -85,9 +95,16 @@ inline void DecisionHeuristicVSIDSdeplearn::precomputeVariableOccurrences(bool u
   }
 }
 
+inline void DecisionHeuristicVSIDSdeplearn::notifyMaxVarDeclaration(Variable max_var) {
+  DecisionHeuristic::notifyMaxVarDeclaration(max_var);
+  variable_activity.reserve(max_var, 0);
+  is_auxiliary.reserve(max_var);
+}
+
 inline void DecisionHeuristicVSIDSdeplearn::addVariable(bool auxiliary) {
   saved_phase.push_back(l_Undef);
   variable_activity.insert(solver.variable_data_store->lastVariable(), 0);
+  bucket_queue.addVariable();
   /* TODO: initialize with a biased activity that favours later variables
    * like 1 - 1/v
    * or   1 - 1/depth(v)
@@ -97,10 +114,11 @@ inline void DecisionHeuristicVSIDSdeplearn::addVariable(bool auxiliary) {
 }
 
 inline void DecisionHeuristicVSIDSdeplearn::notifyStart() {
+  DecisionHeuristic::notifyStart();
   precomputeVariableOccurrences(use_secondary_occurrences_for_tiebreaking);
   for (Variable v = 1; v <= solver.variable_data_store->lastVariable(); v++) {
     if (!is_auxiliary[v - 1] && solver.dependency_manager->isDecisionCandidate(v)) {
-      variable_queue.insert(v);
+      insertIntoVariableQueue(v);
     }
   }
 }
@@ -111,7 +129,7 @@ inline void DecisionHeuristicVSIDSdeplearn::notifyAssigned(Literal l) {
 
 inline void DecisionHeuristicVSIDSdeplearn::notifyEligible(Variable v) {
   if (!is_auxiliary[v - 1]) {
-    variable_queue.update(v);
+    updateVariableQueue(v);
   }
 }
 
@@ -131,8 +149,8 @@ inline void DecisionHeuristicVSIDSdeplearn::notifyBacktrack(uint32_t decision_le
 
 inline void DecisionHeuristicVSIDSdeplearn::bumpVariableScore(Variable v) {
   variable_activity[v] += score_increment;
-  if (variable_queue.inHeap(v)) {
-    variable_queue.update(v);
+  if (inVariableQueue(v)) {
+    updateVariableQueue(v);
   }
   if (variable_activity[v] > 1e60) {
     rescaleVariableScores();
@@ -142,10 +160,13 @@ inline void DecisionHeuristicVSIDSdeplearn::bumpVariableScore(Variable v) {
 inline void DecisionHeuristicVSIDSdeplearn::rescaleVariableScores() {
   for (Variable v = 1; v <= solver.variable_data_store->lastVariable(); v++) {
     variable_activity[v] *= 1e-60;
-    if (variable_queue.inHeap(v)) {
+    if (!use_bucket_queue && variable_queue.inHeap(v)) {
       variable_queue.update(v);
     }
   }
+  if (use_bucket_queue) {
+    bucket_queue.rebuild();
+  }
   score_increment *= 1e-60;
 }
 
@@ -154,8 +175,36 @@ inline void DecisionHeuristicVSIDSdeplearn::decayVariableScores() {
 }
 
 inline Variable DecisionHeuristicVSIDSdeplearn::popFromVariableQueue() {
-  assert(!variable_queue.empty());
-  return variable_queue.removeMin();
+  assert(!variableQueueEmpty());
+  return use_bucket_queue ? bucket_queue.removeTop() : variable_queue.removeMin();
+}
+
+inline bool DecisionHeuristicVSIDSdeplearn::inVariableQueue(Variable v) {
+  return use_bucket_queue ? bucket_queue.inQueue(v) : variable_queue.inHeap(v);
+}
+
+inline void DecisionHeuristicVSIDSdeplearn::insertIntoVariableQueue(Variable v) {
+  if (use_bucket_queue) {
+    bucket_queue.insert(v);
+  } else {
+    variable_queue.insert(v);
+  }
+}
+
+inline void DecisionHeuristicVSIDSdeplearn::updateVariableQueue(Variable v) {
+  if (use_bucket_queue) {
+    bucket_queue.update(v);
+  } else {
+    variable_queue.update(v);
+  }
+}
+
+inline bool DecisionHeuristicVSIDSdeplearn::variableQueueEmpty() {
+  return use_bucket_queue ? bucket_queue.empty() : variable_queue.empty();
+}
+
+inline Variable DecisionHeuristicVSIDSdeplearn::variableQueueTop() {
+  return use_bucket_queue ? bucket_queue.top() : variable_queue[0];
 }
 
 inline double DecisionHeuristicVSIDSdeplearn::getBestDecisionVariableScore() {
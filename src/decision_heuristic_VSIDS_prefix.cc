@@ -0,0 +1,125 @@
+#include "decision_heuristic_VSIDS_prefix.hh"
+
+namespace Qute {
+
+DecisionHeuristicVSIDSprefix::DecisionHeuristicVSIDSprefix(QCDCL_solver& solver, bool no_phase_saving, double score_decay_factor, double score_increment): DecisionHeuristic(solver), last_non_auxiliary(0), no_phase_saving(no_phase_saving), score_decay_factor(score_decay_factor), score_increment(score_increment), ooo_queue(CompareVariables(variable_activity)) {}
+
+void DecisionHeuristicVSIDSprefix::addVariable(bool auxiliary) {
+  Variable v = solver.variable_data_store->lastVariable();
+  is_auxiliary.push_back(auxiliary);
+  saved_phase.push_back(l_Undef);
+  variable_activity.insert(v, 0);
+  if (!auxiliary) {
+    if (last_non_auxiliary == 0 || solver.variable_data_store->varType(v) != solver.variable_data_store->varType(last_non_auxiliary)) {
+      // New quantifier block.
+      blocks.emplace_back(CompareVariables(variable_activity));
+    }
+    blocks.back().num_vars_unassigned++;
+    last_non_auxiliary = v;
+  }
+  variable_depth.push_back(blocks.empty() ? 0 : blocks.size() - 1);
+}
+
+void DecisionHeuristicVSIDSprefix::notifyStart() {
+  DecisionHeuristic::notifyStart();
+  active_block[false] = active_block[true] = blocks.size() + 1;
+  if (blocks.size() > 0) { // At least one quantifier block.
+    Variable first_non_auxiliary = 1;
+    while (is_auxiliary[first_non_auxiliary - 1]) {
+      first_non_auxiliary++;
+    }
+    active_block[solver.variable_data_store->varType(first_non_auxiliary)] = 0;
+    if (blocks.size() > 1) { // At least two quantifier blocks.
+      active_block[!solver.variable_data_store->varType(first_non_auxiliary)] = 1;
+    }
+  }
+  for (Variable v = 1; v <= solver.variable_data_store->lastVariable(); v++) {
+    if (!is_auxiliary[v - 1]) {
+      blocks[variable_depth[v - 1]].queue->insert(v);
+      if (isOOOVariable(v)) {
+        ooo_queue.insert(v);
+      }
+    }
+  }
+}
+
+void DecisionHeuristicVSIDSprefix::notifyUnassigned(Literal l) {
+  Variable v = var(l);
+  if (!is_auxiliary[v - 1]) {
+    bool qtype = solver.variable_data_store->varType(v);
+    uint32_t depth = variable_depth[v - 1];
+    /* Maintain the invariant that all blocks of type i before active_block[i]
+     * have all variables assigned. */
+    if (active_block[qtype] > depth) {
+      active_block[qtype] = depth;
+    }
+    blocks[depth].num_vars_unassigned++;
+    auto& queue = *blocks[depth].queue;
+    if (!queue.inHeap(v)) {
+      queue.insert(v);
+    }
+    if (isOOOVariable(v) && !ooo_queue.inHeap(v) && solver.dependency_manager->isEligibleOOO(v)) {
+      ooo_queue.insert(v);
+    }
+  }
+}
+
+void DecisionHeuristicVSIDSprefix::notifyLearned(Constraint& c, ConstraintType constraint_type, vector<Literal>& conflict_side_literals) {
+  for (auto literal: c) {
+    Variable v = var(literal);
+    if (solver.variable_data_store->isAssigned(v) && !is_auxiliary[v - 1]) {
+      bumpVariableScore(v);
+    }
+  }
+  decayVariableScores();
+}
+
+Literal DecisionHeuristicVSIDSprefix::getDecisionLiteral() {
+  /* Update active blocks so that they point to the leftmost block
+   * with unassigned variables of the respective type. */
+  for (unsigned type = 0; type < 2; type++) {
+    while (active_block[type] < blocks.size() && blocks[active_block[type]].num_vars_unassigned == 0) {
+      active_block[type] += 2;
+    }
+  }
+  /* Only blocks in [free_blocks_begin, free_blocks_end) have all their outer
+   * blocks assigned, and every other one of them is of the right type. */
+  uint32_t free_blocks_begin, free_blocks_end;
+  if (active_block[false] < active_block[true]) {
+    free_blocks_begin = active_block[false];
+    free_blocks_end = active_block[true] < blocks.size() ? active_block[true] : blocks.size();
+  } else {
+    free_blocks_begin = active_block[true];
+    free_blocks_end = active_block[false] < blocks.size() ? active_block[false] : blocks.size();
+  }
+  Variable candidate = 0;
+  for (uint32_t current_block = free_blocks_begin; current_block < free_blocks_end; current_block += 2) {
+    if (blocks[current_block].num_vars_unassigned == 0) {
+      continue;
+    }
+    Variable top = topOfBlock(current_block);
+    // On ties, the outermost block wins.
+    if (candidate == 0 || variable_activity[top] > variable_activity[candidate]) {
+      candidate = top;
+    }
+  }
+  assert(candidate != 0);
+  assert(solver.dependency_manager->isDecisionCandidate(candidate));
+  if (!ooo_queue.empty()) {
+    Variable ooo_candidate = topOfOOOQueue();
+    if (ooo_candidate != 0 && variable_activity[ooo_candidate] > variable_activity[candidate]) {
+      candidate = ooo_candidate;
+    }
+  }
+  return mkLiteral(candidate, decisionPhase(candidate, no_phase_saving));
+}
+
+void DecisionHeuristicVSIDSprefix::rescaleVariableScores() {
+  // Scaling all activities by the same factor keeps the heaps ordered.
+  for (Variable v = 1; v <= solver.variable_data_store->lastVariable(); v++) {
+    variable_activity[v] *= 1e-60;
+  }
+  score_increment *= 1e-60;
+}
+
+}
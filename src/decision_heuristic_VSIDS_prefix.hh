@@ -0,0 +1,141 @@
+#ifndef decision_heuristic_vsids_prefix_hh
+#define decision_heuristic_vsids_prefix_hh
+
+#include "decision_heuristic.hh"
+#include "solver_types.hh"
+#include "constraint.hh"
+#include "variable_data.hh"
+#include "dependency_manager_watched.hh"
+#include "qcdcl.hh"
+
+#include <memory>
+#include "minisat/mtl/Heap.h"
+#include "minisat/mtl/IntMap.h"
+
+using std::unique_ptr;
+using Minisat::Heap;
+using Minisat::IntMap;
+
+namespace Qute {
+
+/* VSIDS for solving without dependency learning. Every quantifier block has
+ * its own heap, and only blocks whose outer blocks are fully assigned are
+ * consulted, so variables that are ineligible because of the prefix are
+ * never popped. Assigned variables are removed lazily when they reach the
+ * top of their heap. */
+class DecisionHeuristicVSIDSprefix: public DecisionHeuristic {
+
+public:
+  DecisionHeuristicVSIDSprefix(QCDCL_solver& solver, bool no_phase_saving, double score_decay_factor, double score_increment);
+  virtual void addVariable(bool auxiliary);
+  virtual void notifyMaxVarDeclaration(Variable max_var);
+  virtual void notifyStart();
+  virtual void notifyAssigned(Literal l);
+  virtual void notifyUnassigned(Literal l);
+  virtual void notifyEligible(Variable v);
+  virtual void notifyLearned(Constraint& c, ConstraintType constraint_type, vector<Literal>& conflict_side_literals);
+  virtual void notifyBacktrack(uint32_t decision_level_before);
+  virtual Literal getDecisionLiteral();
+
+protected:
+  void bumpVariableScore(Variable v);
+  void rescaleVariableScores();
+  void decayVariableScores();
+  Variable topOfBlock(uint32_t block);
+  Variable topOfOOOQueue();
+  bool isOOOVariable(Variable v);
+
+  struct CompareVariables
+  {
+    CompareVariables(const IntMap<Variable, double>& variable_activity): variable_activity(variable_activity) {}
+    bool operator()(const Variable first, const Variable second) const {
+      return variable_activity[first] > variable_activity[second];
+    }
+    const IntMap<Variable, double>& variable_activity;
+  };
+
+  typedef Heap<Variable,CompareVariables> VariableQueue;
+
+  struct BlockData {
+    unique_ptr<VariableQueue> queue;
+    uint32_t num_vars_unassigned;
+    BlockData(const CompareVariables& compare): queue(new VariableQueue(compare)), num_vars_unassigned(0) {}
+  };
+
+  vector<bool> is_auxiliary;
+  vector<uint32_t> variable_depth;
+  vector<BlockData> blocks;
+  uint32_t active_block[2];
+  Variable last_non_auxiliary;
+  bool no_phase_saving;
+  double score_decay_factor;
+  double score_increment;
+  IntMap<Variable, double> variable_activity;
+  // Variables of a type that may be decided out of order, popped once found ineligible.
+  VariableQueue ooo_queue;
+};
+
+// Implementation of inline methods
+
+inline void DecisionHeuristicVSIDSprefix::notifyMaxVarDeclaration(Variable max_var) {
+  DecisionHeuristic::notifyMaxVarDeclaration(max_var);
+  variable_activity.reserve(max_var, 0);
+  is_auxiliary.reserve(max_var);
+  variable_depth.reserve(max_var);
+}
+
+inline void DecisionHeuristicVSIDSprefix::notifyAssigned(Literal l) {
+  if (!is_auxiliary[var(l) - 1]) {
+    blocks[variable_depth[var(l) - 1]].num_vars_unassigned--;
+  }
+  saved_phase[var(l) - 1] = sign(l);
+}
+
+inline void DecisionHeuristicVSIDSprefix::notifyEligible(Variable v) {
+  if (isOOOVariable(v) && !solver.variable_data_store->isAssigned(v)) {
+    ooo_queue.update(v);
+  }
+}
+
+inline void DecisionHeuristicVSIDSprefix::notifyBacktrack(uint32_t decision_level_before) {}
+
+inline bool DecisionHeuristicVSIDSprefix::isOOOVariable(Variable v) {
+  return !is_auxiliary[v - 1] && solver.dependency_manager->out_of_order_decisions[solver.variable_data_store->varType(v)];
+}
+
+inline void DecisionHeuristicVSIDSprefix::bumpVariableScore(Variable v) {
+  variable_activity[v] += score_increment;
+  auto& queue = *blocks[variable_depth[v - 1]].queue;
+  if (queue.inHeap(v)) {
+    queue.update(v);
+  }
+  if (ooo_queue.inHeap(v)) {
+    ooo_queue.update(v);
+  }
+  if (variable_activity[v] > 1e60) {
+    rescaleVariableScores();
+  }
+}
+
+inline void DecisionHeuristicVSIDSprefix::decayVariableScores() {
+  score_increment *= (1 / score_decay_factor);
+}
+
+inline Variable DecisionHeuristicVSIDSprefix::topOfBlock(uint32_t block) {
+  auto& queue = *blocks[block].queue;
+  while (!queue.empty() && solver.variable_data_store->isAssigned(queue[0])) {
+    queue.removeMin();
+  }
+  return queue.empty() ? 0 : queue[0];
+}
+
+inline Variable DecisionHeuristicVSIDSprefix::topOfOOOQueue() {
+  while (!ooo_queue.empty() && (solver.variable_data_store->isAssigned(ooo_queue[0]) || !solver.dependency_manager->isEligibleOOO(ooo_queue[0]))) {
+    ooo_queue.removeMin();
+  }
+  return ooo_queue.empty() ? 0 : ooo_queue[0];
+}
+
+}
+
+#endif
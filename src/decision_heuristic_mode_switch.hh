@@ -0,0 +1,138 @@
+#ifndef decision_heuristic_mode_switch_hh
+#define decision_heuristic_mode_switch_hh
+
+#include <memory>
+#include "decision_heuristic.hh"
+
+using std::unique_ptr;
+
+namespace Qute {
+
+/* Owns one heuristic for the focused and one for the stable mode of search.
+ * Every event is forwarded to both, so the heuristic of the other mode is
+ * always up to date and switching only changes which of them is asked for
+ * decisions. The mode is set by RestartSchedulerModeSwitch. */
+class DecisionHeuristicModeSwitch: public DecisionHeuristic {
+
+public:
+  DecisionHeuristicModeSwitch(QCDCL_solver& solver, unique_ptr<DecisionHeuristic> focused, unique_ptr<DecisionHeuristic> stable);
+  virtual void addVariable(bool auxiliary);
+  virtual void notifyMaxVarDeclaration(Variable max_var);
+  virtual void notifyStart();
+  virtual void notifyAssigned(Literal l);
+  virtual void notifyUnassigned(Literal l);
+  virtual void notifyEligible(Variable v);
+  virtual void notifyLearned(Constraint& c, ConstraintType constraint_type, vector<Literal>& conflict_side_literals);
+  virtual void notifyBacktrack(uint32_t decision_level_before);
+  virtual Literal getDecisionLiteral();
+  virtual void notifyConflict(ConstraintType constraint_type);
+  virtual void notifyRestart();
+  virtual void updateTargetPhases();
+  virtual void notifyInputConstraintAdded(Constraint& c, ConstraintType constraint_type);
+  virtual void notifyInputConstraintRemoved(Constraint& c, ConstraintType constraint_type);
+  void setStable(bool stable);
+  bool isStable() const;
+
+protected:
+  unique_ptr<DecisionHeuristic> heuristics[2]; // indexed by whether the mode is stable
+  bool stable;
+
+};
+
+// Implementation of inline methods.
+
+inline DecisionHeuristicModeSwitch::DecisionHeuristicModeSwitch(QCDCL_solver& solver, unique_ptr<DecisionHeuristic> focused, unique_ptr<DecisionHeuristic> stable): DecisionHeuristic(solver), heuristics{std::move(focused), std::move(stable)}, stable(false) {}
+
+inline void DecisionHeuristicModeSwitch::addVariable(bool auxiliary) {
+  for (auto& heuristic: heuristics) {
+    heuristic->addVariable(auxiliary);
+  }
+}
+
+inline void DecisionHeuristicModeSwitch::notifyMaxVarDeclaration(Variable max_var) {
+  for (auto& heuristic: heuristics) {
+    heuristic->notifyMaxVarDeclaration(max_var);
+  }
+}
+
+inline void DecisionHeuristicModeSwitch::notifyStart() {
+  for (auto& heuristic: heuristics) {
+    heuristic->notifyStart();
+  }
+}
+
+inline void DecisionHeuristicModeSwitch::notifyAssigned(Literal l) {
+  for (auto& heuristic: heuristics) {
+    heuristic->notifyAssigned(l);
+  }
+}
+
+inline void DecisionHeuristicModeSwitch::notifyUnassigned(Literal l) {
+  for (auto& heuristic: heuristics) {
+    heuristic->notifyUnassigned(l);
+  }
+}
+
+inline void DecisionHeuristicModeSwitch::notifyEligible(Variable v) {
+  for (auto& heuristic: heuristics) {
+    heuristic->notifyEligible(v);
+  }
+}
+
+inline void DecisionHeuristicModeSwitch::notifyLearned(Constraint& c, ConstraintType constraint_type, vector<Literal>& conflict_side_literals) {
+  for (auto& heuristic: heuristics) {
+    heuristic->notifyLearned(c, constraint_type, conflict_side_literals);
+  }
+}
+
+inline void DecisionHeuristicModeSwitch::notifyBacktrack(uint32_t decision_level_before) {
+  for (auto& heuristic: heuristics) {
+    heuristic->notifyBacktrack(decision_level_before);
+  }
+}
+
+inline Literal DecisionHeuristicModeSwitch::getDecisionLiteral() {
+  return heuristics[stable]->getDecisionLiteral();
+}
+
+inline void DecisionHeuristicModeSwitch::notifyConflict(ConstraintType constraint_type) {
+  for (auto& heuristic: heuristics) {
+    heuristic->notifyConflict(constraint_type);
+  }
+}
+
+inline void DecisionHeuristicModeSwitch::notifyRestart() {
+  for (auto& heuristic: heuristics) {
+    heuristic->notifyRestart();
+  }
+}
+
+inline void DecisionHeuristicModeSwitch::updateTargetPhases() {
+  for (auto& heuristic: heuristics) {
+    heuristic->updateTargetPhases();
+  }
+}
+
+inline void DecisionHeuristicModeSwitch::notifyInputConstraintAdded(Constraint& c, ConstraintType constraint_type) {
+  for (auto& heuristic: heuristics) {
+    heuristic->notifyInputConstraintAdded(c, constraint_type);
+  }
+}
+
+inline void DecisionHeuristicModeSwitch::notifyInputConstraintRemoved(Constraint& c, ConstraintType constraint_type) {
+  for (auto& heuristic: heuristics) {
+    heuristic->notifyInputConstraintRemoved(c, constraint_type);
+  }
+}
+
+inline void DecisionHeuristicModeSwitch::setStable(bool stable) {
+  this->stable = stable;
+}
+
+inline bool DecisionHeuristicModeSwitch::isStable() const {
+  return stable;
+}
+
+}
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef decision_heuristic_recorder_hh
+#define decision_heuristic_recorder_hh
+
+#include "decision_heuristic.hh"
+#include "heuristic_event_log.hh"
+#include "qcdcl.hh"
+#include "variable_data.hh"
+
+namespace Qute {
+
+/* Forwards everything to the wrapped heuristic while writing the events a
+ * replay needs to a heuristic event log. Eligibility notifications are not
+ * recorded, a replay recreates them from the recorded dependencies. */
+class DecisionHeuristicRecorder: public DecisionHeuristic {
+
+public:
+  DecisionHeuristicRecorder(QCDCL_solver& solver, DecisionHeuristic& heuristic, HeuristicEventWriter& writer);
+  virtual void addVariable(bool auxiliary);
+  virtual void notifyMaxVarDeclaration(Variable max_var);
+  virtual void notifyStart();
+  virtual void notifyAssigned(Literal l);
+  virtual void notifyUnassigned(Literal l);
+  virtual void notifyEligible(Variable v);
+  virtual void notifyLearned(Constraint& c, ConstraintType constraint_type, vector<Literal>& conflict_side_literals);
+  virtual void notifyBacktrack(uint32_t decision_level_before);
+  virtual Literal getDecisionLiteral();
+  virtual void notifyConflict(ConstraintType constraint_type);
+  virtual void notifyRestart();
+  virtual void updateTargetPhases();
+  virtual void notifyInputConstraintAdded(Constraint& c, ConstraintType constraint_type);
+  virtual void notifyInputConstraintRemoved(Constraint& c, ConstraintType constraint_type);
+
+protected:
+  DecisionHeuristic& heuristic;
+  HeuristicEventWriter& writer;
+
+};
+
+// Implementation of inline methods.
+
+inline DecisionHeuristicRecorder::DecisionHeuristicRecorder(QCDCL_solver& solver, DecisionHeuristic& heuristic, HeuristicEventWriter& writer): DecisionHeuristic(solver), heuristic(heuristic), writer(writer) {}
+
+inline void DecisionHeuristicRecorder::addVariable(bool auxiliary) {
+  heuristic.addVariable(auxiliary);
+}
+
+inline void DecisionHeuristicRecorder::notifyMaxVarDeclaration(Variable max_var) {
+  heuristic.notifyMaxVarDeclaration(max_var);
+}
+
+inline void DecisionHeuristicRecorder::notifyStart() {
+  heuristic.notifyStart();
+}
+
+inline void DecisionHeuristicRecorder::notifyAssigned(Literal l) {
+  writer.assigned(l, solver.variable_data_store->varReason(var(l)) == CRef_Undef);
+  heuristic.notifyAssigned(l);
+}
+
+inline void DecisionHeuristicRecorder::notifyUnassigned(Literal l) {
+  writer.unassigned(l);
+  heuristic.notifyUnassigned(l);
+}
+
+inline void DecisionHeuristicRecorder::notifyEligible(Variable v) {
+  heuristic.notifyEligible(v);
+}
+
+inline void DecisionHeuristicRecorder::notifyLearned(Constraint& c, ConstraintType constraint_type, vector<Literal>& conflict_side_literals) {
+  writer.learned(c, constraint_type, conflict_side_literals);
+  heuristic.notifyLearned(c, constraint_type, conflict_side_literals);
+}
+
+inline void DecisionHeuristicRecorder::notifyBacktrack(uint32_t decision_level_before) {
+  writer.backtrack(decision_level_before);
+  heuristic.notifyBacktrack(decision_level_before);
+}
+
+inline Literal DecisionHeuristicRecorder::getDecisionLiteral() {
+  Literal l = heuristic.getDecisionLiteral();
+  writer.decision(l);
+  return l;
+}
+
+inline void DecisionHeuristicRecorder::notifyConflict(ConstraintType constraint_type) {
+  writer.conflict(constraint_type);
+  heuristic.notifyConflict(constraint_type);
+}
+
+inline void DecisionHeuristicRecorder::notifyRestart() {
+  heuristic.notifyRestart();
+}
+
+inline void DecisionHeuristicRecorder::updateTargetPhases() {
+  heuristic.updateTargetPhases();
+}
+
+inline void DecisionHeuristicRecorder::notifyInputConstraintAdded(Constraint& c, ConstraintType constraint_type) {
+  heuristic.notifyInputConstraintAdded(c, constraint_type);
+}
+
+inline void DecisionHeuristicRecorder::notifyInputConstraintRemoved(Constraint& c, ConstraintType constraint_type) {
+  heuristic.notifyInputConstraintRemoved(c, constraint_type);
+}
+
+}
+
+#endif
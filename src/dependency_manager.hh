@@ -10,6 +10,7 @@ class DependencyManager {
 public:
   virtual ~DependencyManager() {}
   virtual void addVariable(bool auxiliary, bool qtype) = 0;
+  virtual void notifyMaxVarDeclaration(Variable max_var) {}
   virtual void addDependency(Variable of, Variable on) = 0;
   virtual void notifyStart() = 0;
   virtual void notifyAssigned(Variable v) = 0;
@@ -20,6 +21,8 @@ public:
   virtual void learnDependencies(Variable unit_variable, vector<Literal>& literal_vector) = 0;
   virtual void reduceWithDepscheme(std::vector<bool>& characteristic_function, Literal& rightmost_primary, ConstraintType constraint_type) = 0;
   virtual void filterIndependentVariables(Variable unit_variable, vector<Literal>& literal_vector) = 0;
+  // Called for every input clause that is added once search has started.
+  virtual void notifyInputClauseAdded(const vector<Literal>& literals) {}
 
 	// TODO should change the nomenclature:
 	// 	reduceWitHRRS should be reduceWithDepScheme
@@ -5,17 +5,65 @@
 #include <queue>
 #include <unordered_map>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 
 namespace Qute {
 
 using std::priority_queue;
 using std::unordered_map;
 
-DependencyManagerRRS::DependencyManagerRRS(QCDCL_solver& solver, string dependency_learning_strategy, string out_of_order_decisions): DependencyManagerWatched(solver, dependency_learning_strategy, out_of_order_decisions) {
+DependencyManagerRRS::DependencyManagerRRS(QCDCL_solver& solver, string dependency_learning_strategy, string out_of_order_decisions, bool precompute, unsigned precompute_threads, bool bit_parallel, string independence_cache_directory): DependencyManagerWatched(solver, dependency_learning_strategy, out_of_order_decisions, independence_cache_directory), precompute(precompute), precompute_threads(precompute_threads), bit_parallel(bit_parallel) {
+}
+
+void DependencyManagerRRS::notifyStart() {
+  DependencyManagerWatched::notifyStart();
+  if (!independence_cache_directory.empty()) {
+    string cache_file = independenceCacheFile("rrs");
+    if (!loadIndependencies(cache_file)) {
+      precomputeDepsRRS();
+      saveIndependencies(cache_file);
+    }
+  } else if (precompute) {
+    precomputeDepsRRS();
+  }
+}
+
+void DependencyManagerRRS::notifyInputClauseAdded(const vector<Literal>& literals) {
+  added_clause_literals.insert(added_clause_literals.end(), literals.begin(), literals.end());
+}
+
+/* Discards the independencies that clauses added during search may have
+ * broken. The independencies of a pair x < v are stored with v, and the pair
+ * can only have gained a path if x < depth(x) and x < depth(v) (see
+ * addedClausePathDepths), so it suffices to check the leftmost candidate x. */
+void DependencyManagerRRS::updateAfterAddedClauses() {
+  if (added_clause_literals.empty()) {
+    return;
+  }
+  vector<Variable> depth = addedClausePathDepths();
+  Variable last_variable = solver.variable_data_store->lastVariable();
+  Variable leftmost_candidate[2] = {last_variable + 1, last_variable + 1};
+  bool invalidated = false;
+  for (Variable v = 1; v <= last_variable; v++) {
+    bool vqtype = solver.variable_data_store->varType(v);
+    if (leftmost_candidate[!vqtype] < depth[v] && independenciesKnown(v)) {
+      invalidateIndependencies(v);
+      invalidated = true;
+    }
+    if (v < depth[v] && leftmost_candidate[vqtype] > v) {
+      leftmost_candidate[vqtype] = v;
+    }
+  }
+  if (invalidated && precompute) {
+    precomputeDepsRRS();
+  }
 }
 
 void DependencyManagerRRS::filterIndependentVariables(Variable unit_variable, vector<Literal>& literal_vector) {
   solver.solver_statistics.backtracks_dep++;
+  updateAfterAddedClauses();
   if (!variable_dependencies[unit_variable - 1].independencies_known) {
     // only compute more independencies if there is time
     /*
@@ -39,15 +87,17 @@ void DependencyManagerRRS::filterIndependentVariables(Variable unit_variable, ve
 }
 
 void DependencyManagerRRS::reduceWithDepscheme(vector<bool>& characteristic_function, Literal& rightmost_primary, ConstraintType constraint_type) {
+    updateAfterAddedClauses();
     clock_t t = clock();
-    vector<Variable> blockers;
+    // Literals are visited right to left, so each blocker sees its queries in descending order.
+    vector<IndependenceSet::DescendingLookup> blockers;
     int bound = Min_Literal_Int;
     for (int i = toInt(rightmost_primary); i >= bound; i--) {
       if (characteristic_function[i]) {
         Variable v = i >> 1;
         if (solver.variable_data_store->varType(v) == constraint_type) {
           if (independenciesKnown(v) && numIndependencies(v) > 0) {
-            blockers.push_back(v);
+            blockers.emplace_back(variable_dependencies[v - 1].independent_of);
             int new_bound = leftmostIndependent(v) * 2;
             bound = bound < new_bound ? new_bound : bound;
           } else {
@@ -55,9 +105,8 @@ void DependencyManagerRRS::reduceWithDepscheme(vector<bool>& characteristic_func
           }
         } else {
           bool can_be_reduced = true;
-          for (Variable blocker : blockers) {
-            // TODO: queries for a given blocker are in sorted order, can be optimized
-            if (!notDependsOn(blocker, v)) {
+          for (auto& blocker : blockers) {
+            if (!blocker.contains(indexInType(v))) {
               can_be_reduced = false;
               break;
             }
@@ -76,7 +125,153 @@ void DependencyManagerRRS::reduceWithDepscheme(vector<bool>& characteristic_func
 }
 
 void DependencyManagerRRS::getDepsRRS(Variable v) {
+  if (bit_parallel) {
+    // The bit-parallel backend only works on all variables at once.
+    precomputeDepsRRS();
+    return;
+  }
   clock_t t = clock();
+  vector<Variable> independent_of;
+  computeIndependencies(v, independent_of);
+  storeIndependencies(v, independent_of);
+  solver.solver_statistics.time_spent_computing_depscheme += clock()-t;
+}
+
+// Computes the independencies of all variables up front.
+void DependencyManagerRRS::precomputeDepsRRS() {
+  clock_t t = clock();
+  auto wall_clock_start = std::chrono::steady_clock::now();
+  vector<vector<Variable>> independencies(solver.variable_data_store->lastVariable());
+  if (bit_parallel) {
+    computeAllIndependenciesBitParallel(independencies);
+  } else {
+    computeAllIndependenciesThreaded(independencies);
+  }
+  for (Variable v = 1; v <= solver.variable_data_store->lastVariable(); v++) {
+    if (!variable_dependencies[v - 1].independencies_known) {
+      storeIndependencies(v, independencies[v - 1]);
+      vector<Variable>().swap(independencies[v - 1]);
+    }
+  }
+  solver.solver_statistics.time_spent_computing_depscheme += clock()-t;
+  solver.solver_statistics.wall_time_precomputing_depscheme += std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_clock_start).count();
+}
+
+/* Each variable only needs two reachability searches over the (unchanging)
+ * input clauses, so variables are handed out to worker threads one at a time.
+ * Workers only read solver state and write the independencies of their own
+ * variable. */
+void DependencyManagerRRS::computeAllIndependenciesThreaded(vector<vector<Variable>>& independencies) {
+  Variable last_variable = solver.variable_data_store->lastVariable();
+  unsigned nr_threads = precompute_threads ? precompute_threads : std::max(std::thread::hardware_concurrency(), 1u);
+  std::atomic<Variable> next_variable(1);
+  auto worker = [this, &independencies, &next_variable, last_variable]() {
+    for (Variable v = next_variable++; v <= last_variable; v = next_variable++) {
+      if (!variable_dependencies[v - 1].independencies_known) {
+        computeIndependencies(v, independencies[v - 1]);
+      }
+    }
+  };
+  vector<std::thread> workers;
+  for (unsigned i = 1; i < nr_threads; i++) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread: workers) {
+    thread.join();
+  }
+}
+
+/* Resolution paths can be reversed, so instead of searching from every
+ * variable v for the variables x < v it depends on, we can search from the
+ * literals of x for the literals of all v > x at once. A path from x may only
+ * pass through existential connecting variables right of x; this is the only
+ * place where x enters the search, so 32 variables x (both polarities, one bit
+ * each) are handled together in a single sweep over the occurrence lists.
+ *
+ * For a literal l, landed[l] holds the sources for which the clauses
+ * containing l have been entered via l, pending[l] those of them that have
+ * not been propagated yet, and reached[l] the sources for which l lies on a
+ * clause along some path. v depends on x iff x and -x reach different
+ * polarities of v. */
+void DependencyManagerRRS::computeAllIndependenciesBitParallel(vector<vector<Variable>>& independencies) {
+  const uint32_t batch_size = 32;
+  Variable last_variable = solver.variable_data_store->lastVariable();
+  uint32_t num_lits = last_variable * 2 + 2; // literals start at 2
+  vector<uint64_t> landed(num_lits), pending(num_lits), reached(num_lits);
+  vector<Literal> landing_literals;
+
+  for (Variable first = 1; first <= last_variable; first += batch_size) {
+    Variable last = std::min(first + static_cast<Variable>(batch_size) - 1, last_variable);
+    std::fill(landed.begin(), landed.end(), 0);
+    std::fill(reached.begin(), reached.end(), 0);
+    for (Variable x = first; x <= last; x++) {
+      uint32_t shift = 2 * (x - first);
+      Literal x_pos = mkLiteral(x, true), x_neg = mkLiteral(x, false);
+      landed[toInt(x_pos)] = pending[toInt(x_pos)] = uint64_t(1) << shift;
+      landed[toInt(x_neg)] = pending[toInt(x_neg)] = uint64_t(2) << shift;
+      landing_literals.push_back(x_pos);
+      landing_literals.push_back(x_neg);
+    }
+
+    while (!landing_literals.empty()) {
+      Literal current_lit = landing_literals.back();
+      landing_literals.pop_back();
+      uint64_t sources = pending[toInt(current_lit)];
+      pending[toInt(current_lit)] = 0;
+      for (auto occit = solver.constraint_database->literalOccurrencesBegin(current_lit, ConstraintType::clauses);
+            occit != solver.constraint_database->literalOccurrencesEnd(current_lit, ConstraintType::clauses);
+            occit++) {
+        Constraint& clause = solver.constraint_database->getConstraint(*occit, ConstraintType::clauses);
+        for (Literal lit : clause) {
+          if (lit == current_lit) {
+            continue;
+          }
+          reached[toInt(lit)] |= sources;
+          Variable lit_var = var(lit);
+          if (solver.variable_data_store->varType(lit_var) == 0 && lit_var > first) {
+            // Only sources strictly left of the connecting variable may pass.
+            uint32_t nr_left = std::min<uint32_t>(lit_var - first, last - first + 1);
+            uint64_t allowed = nr_left == batch_size ? ~uint64_t(0) : (uint64_t(1) << (2 * nr_left)) - 1;
+            uint64_t new_sources = sources & allowed & ~landed[toInt(~lit)];
+            if (new_sources) {
+              landed[toInt(~lit)] |= new_sources;
+              if (!pending[toInt(~lit)]) {
+                landing_literals.push_back(~lit);
+              }
+              pending[toInt(~lit)] |= new_sources;
+            }
+          }
+        }
+      }
+    }
+
+    for (Variable v = first + 1; v <= last_variable; v++) {
+      if (variable_dependencies[v - 1].independencies_known) {
+        continue;
+      }
+      bool vqtype = solver.variable_data_store->varType(v);
+      uint64_t reached_pos = reached[toInt(mkLiteral(v, true))];
+      uint64_t reached_neg = reached[toInt(mkLiteral(v, false))];
+      // Pair up x with -x: bit 2i of crossed is set iff (x, -v) and (-x, v) are both connected.
+      uint64_t crossed = ((reached_pos >> 1) & reached_neg) | ((reached_neg >> 1) & reached_pos);
+      for (Variable x = first; x <= last && x < v; x++) {
+        if (solver.variable_data_store->varType(x) != vqtype && !((crossed >> (2 * (x - first))) & 1)) {
+          independencies[v - 1].push_back(x);
+        }
+      }
+    }
+  }
+}
+
+// Appends the variables that v is independent of, in increasing order.
+void DependencyManagerRRS::storeIndependencies(Variable v, const vector<Variable>& independent_of) {
+  variable_dependencies[v - 1].independent_of.assign(independent_of, [this](Variable x) { return indexInType(x); });
+  variable_dependencies[v - 1].independencies_known = true;
+  solver.solver_statistics.nr_independencies += independent_of.size();
+}
+
+void DependencyManagerRRS::computeIndependencies(Variable v, vector<Variable>& independent_of) {
   bool vqtype = solver.variable_data_store->varType(v);
 
   vector<bool> reachable_true = getReachable(mkLiteral(v, true));
@@ -91,12 +286,10 @@ void DependencyManagerRRS::getDepsRRS(Variable v) {
       }
       else {
         // independence detected
-        addNonDependency(v, xvar);
+        independent_of.push_back(xvar);
       }
     }
   }
-  variable_dependencies[v - 1].independencies_known = true;
-  solver.solver_statistics.time_spent_computing_depscheme += clock()-t;
 }
 
 vector<bool> DependencyManagerRRS::getReachable(Literal l) {
@@ -213,9 +406,4 @@ vector<bool> DependencyManagerRRS::getReachable(Literal l) {
   return reachable;
 }
 
-void DependencyManagerRRS::addNonDependency(Variable of, Variable on) {
-  solver.solver_statistics.nr_independencies++;
-  variable_dependencies[of - 1].independent_of.push_back(on);
-}
-
 }
@@ -22,18 +22,29 @@ friend class DecisionHeuristicVSIDSdeplearn;
 friend class DecisionHeuristicSGDB;
 
 public:
-  DependencyManagerRRS(QCDCL_solver& solver, string dependency_learning_strategy, string out_of_order_decisions);
+  DependencyManagerRRS(QCDCL_solver& solver, string dependency_learning_strategy, string out_of_order_decisions, bool precompute = false, unsigned precompute_threads = 0, bool bit_parallel = false, string independence_cache_directory = "");
+  virtual void notifyStart();
   virtual void reduceWithDepscheme(std::vector<bool>& characteristic_function, Literal& rightmost_primary, ConstraintType constraint_type);
   virtual void filterIndependentVariables(Variable unit_variable, vector<Literal>& literal_vector);
+  virtual void notifyInputClauseAdded(const vector<Literal>& literals);
 
 protected:
+  void updateAfterAddedClauses();
   void getDepsRRS(Variable v);
+  void precomputeDepsRRS();
+  void computeIndependencies(Variable v, vector<Variable>& independent_of);
+  void computeAllIndependenciesThreaded(vector<vector<Variable>>& independencies);
+  void computeAllIndependenciesBitParallel(vector<vector<Variable>>& independencies);
+  void storeIndependencies(Variable v, const vector<Variable>& independent_of);
   vector<bool> getReachable(Literal l);
   bool notDependsOn(Variable of, Variable on) const;
   bool independenciesKnown(Variable of) const;
-  bool numIndependencies(Variable of) const;
-  bool leftmostIndependent(Variable of) const;
-  void addNonDependency(Variable of, Variable on);
+  uint32_t numIndependencies(Variable of) const;
+  Variable leftmostIndependent(Variable of) const;
+
+  bool precompute;
+  unsigned precompute_threads;
+  bool bit_parallel;
 
 };
 
@@ -43,18 +54,16 @@ inline bool DependencyManagerRRS::independenciesKnown(Variable of) const {
   return variable_dependencies[of - 1].independencies_known;
 }
 
-inline bool DependencyManagerRRS::numIndependencies(Variable of) const {
+inline uint32_t DependencyManagerRRS::numIndependencies(Variable of) const {
   return variable_dependencies[of - 1].independent_of.size();
 }
 
-inline bool DependencyManagerRRS::leftmostIndependent(Variable of) const {
-  return variable_dependencies[of - 1].independent_of[0];
+inline Variable DependencyManagerRRS::leftmostIndependent(Variable of) const {
+  return variable_dependencies[of - 1].independent_of.leftmost();
 }
 
 inline bool DependencyManagerRRS::notDependsOn(Variable of, Variable on) const {
-	return std::binary_search(variable_dependencies[of - 1].independent_of.begin(),
-							  variable_dependencies[of - 1].independent_of.end(),
-							  on);
+  return !sameType(of, on) && variable_dependencies[of - 1].independent_of.contains(indexInType(on));
 }
 
 }
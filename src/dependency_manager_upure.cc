@@ -7,7 +7,43 @@
 
 namespace Qute {
 
-	DependencyManagerUPure::DependencyManagerUPure(QCDCL_solver& solver, string dependency_learning_strategy, string out_of_order_decisions): DependencyManagerWatched(solver, dependency_learning_strategy, out_of_order_decisions) {
+	DependencyManagerUPure::DependencyManagerUPure(QCDCL_solver& solver, string dependency_learning_strategy, string out_of_order_decisions, string independence_cache_directory): DependencyManagerWatched(solver, dependency_learning_strategy, out_of_order_decisions, independence_cache_directory) {
+	}
+
+	void DependencyManagerUPure::notifyStart() {
+		DependencyManagerWatched::notifyStart();
+		if (!independence_cache_directory.empty()) {
+			string cache_file = independenceCacheFile("upure");
+			if (!loadIndependencies(cache_file)) {
+				// the cache must hold the independencies of every variable
+				for (Variable v = 1; v <= solver.variable_data_store->lastVariable(); v++)
+					getDepsUPure(v);
+				saveIndependencies(cache_file);
+			}
+		}
+	}
+
+	void DependencyManagerUPure::notifyInputClauseAdded(const vector<Literal>& literals) {
+		added_clause_literals.insert(added_clause_literals.end(), literals.begin(), literals.end());
+	}
+
+	/*
+	 * discards the independencies that clauses added during search may have broken.
+	 * the independencies of a pair x < v are stored with x, and u-pure paths may
+	 * also connect through x itself, so the pair can only have gained a path if
+	 * x <= depth(x) and x <= depth(v) (see addedClausePathDepths)
+	 */
+	void DependencyManagerUPure::updateAfterAddedClauses() {
+		if (added_clause_literals.empty())
+			return;
+		vector<Variable> depth = addedClausePathDepths();
+		Variable deepest_right_of[2] = {0, 0};
+		for (Variable x = solver.variable_data_store->lastVariable(); x >= 1; x--) {
+			bool xqtype = solver.variable_data_store->varType(x);
+			if (x <= depth[x] && x <= deepest_right_of[!xqtype])
+				invalidateIndependencies(x);
+			deepest_right_of[xqtype] = std::max(deepest_right_of[xqtype], depth[x]);
+		}
 	}
 
 	void DependencyManagerUPure::filterIndependentVariables(Variable unit_variable, vector<Literal>& literal_vector) {
@@ -15,6 +51,7 @@ namespace Qute {
 			return;
 		}
 		solver.solver_statistics.backtracks_dep++;
+		updateAfterAddedClauses();
 		/*
 		 * only compute more independencies if there is time
 		 clock_t n = 3, c = 30;
@@ -40,6 +77,7 @@ namespace Qute {
 	}
 
 	void DependencyManagerUPure::reduceWithDepscheme(vector<bool>& characteristic_function, Literal& rightmost_primary, ConstraintType constraint_type) {
+		updateAfterAddedClauses();
 		clock_t t = clock();
 		vector<Variable> blockers;
 		int bound = Min_Literal_Int;
@@ -50,9 +88,10 @@ namespace Qute {
 						blockers.push_back(v);
 				} else if (independenciesKnown(v)) {
 					bool can_be_reduced = true;
+					// blockers were collected right to left, so the queries for v are in descending order
+					IndependenceSet::DescendingLookup independent_of_v(variable_dependencies[v - 1].independent_of);
 					for (Variable blocker : blockers) {
-						// TODO: queries for v are in sorted order, can be optimized
-						if (!notDependsOn(blocker, v)) {
+						if (!independent_of_v.contains(indexInType(blocker))) {
 							//std::cout << "the blocking variable " << solver.externalize(mkLiteral(blocker, false)) << " is preventing reduction of " << solver.externalize(mkLiteral(v, false)) << std::endl;
 							can_be_reduced = false;
 							break;
@@ -80,6 +119,7 @@ namespace Qute {
 			return;
 		clock_t t = clock();
 		bool vqtype = solver.variable_data_store->varType(v);
+		vector<Variable> independent_of;
 
 		vector<bool> reachable_true = getReachable(mkLiteral(v, true));
 		vector<bool> reachable_false = getReachable(mkLiteral(v, false));
@@ -94,11 +134,13 @@ namespace Qute {
 				else {
 					// independence detected
 					//std::cout << "Found that " << solver.externalize(mkLiteral(xvar)) << " does not depend on " << solver.externalize(mkLiteral(v)) << std::endl; 
-					addNonDependency(xvar, v);
+					independent_of.push_back(xvar);
 				}
 			}
 		}
+		variable_dependencies[v - 1].independent_of.assign(independent_of, [this](Variable x) { return indexInType(x); });
 		variable_dependencies[v - 1].independencies_known = true;
+		solver.solver_statistics.nr_independencies += independent_of.size();
 		solver.solver_statistics.time_spent_computing_depscheme += clock()-t;
 	}
 
@@ -192,9 +234,4 @@ namespace Qute {
 		return reachable;
 	}
 
-	void DependencyManagerUPure::addNonDependency(Variable of, Variable on) {
-		solver.solver_statistics.nr_independencies++;
-		variable_dependencies[on - 1].independent_of.push_back(of);
-	}
-
 }
@@ -22,19 +22,21 @@ friend class DecisionHeuristicVSIDSdeplearn;
 friend class DecisionHeuristicSGDB;
 
 public:
-  DependencyManagerUPure(QCDCL_solver& solver, string dependency_learning_strategy, string out_of_order_decisions);
+  DependencyManagerUPure(QCDCL_solver& solver, string dependency_learning_strategy, string out_of_order_decisions, string independence_cache_directory = "");
+  virtual void notifyStart();
   virtual void reduceWithDepscheme(std::vector<bool>& characteristic_function, Literal& rightmost_primary, ConstraintType constraint_type);
   virtual void filterIndependentVariables(Variable unit_variable, vector<Literal>& literal_vector);
+  virtual void notifyInputClauseAdded(const vector<Literal>& literals);
 
 protected:
   void getDepsUPure(Variable v);
+  void updateAfterAddedClauses();
   vector<bool> getReachable(Literal l);
   bool notDependsOn(Variable of, Variable on) const;
   //bool checkDependency(Variable of, Literal lof);
   bool independenciesKnown(Variable of) const;
-  bool numIndependencies(Variable of) const;
-  bool leftmostIndependent(Variable of) const;
-  void addNonDependency(Variable of, Variable on);
+  uint32_t numIndependencies(Variable of) const;
+  Variable leftmostIndependent(Variable of) const;
 
 };
 
@@ -44,18 +46,16 @@ inline bool DependencyManagerUPure::independenciesKnown(Variable on) const {
   return variable_dependencies[on - 1].independencies_known;
 }
 
-inline bool DependencyManagerUPure::numIndependencies(Variable on) const {
+inline uint32_t DependencyManagerUPure::numIndependencies(Variable on) const {
   return variable_dependencies[on - 1].independent_of.size();
 }
 
-inline bool DependencyManagerUPure::leftmostIndependent(Variable on) const {
-  return variable_dependencies[on - 1].independent_of[0];
+inline Variable DependencyManagerUPure::leftmostIndependent(Variable on) const {
+  return variable_dependencies[on - 1].independent_of.leftmost();
 }
 
 inline bool DependencyManagerUPure::notDependsOn(Variable of, Variable on) const {
-	return std::binary_search(variable_dependencies[on - 1].independent_of.begin(),
-							  variable_dependencies[on - 1].independent_of.end(),
-							  of);
+  return !sameType(of, on) && variable_dependencies[on - 1].independent_of.contains(indexInType(of));
 }
 
 }
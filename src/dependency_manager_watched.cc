@@ -1,12 +1,22 @@
 #include "dependency_manager_watched.hh"
 #include "qcdcl.hh"
 #include "variable_data.hh"
+#include "constraint_DB.hh"
 #include "decision_heuristic.hh"
+#include "heuristic_event_log.hh"
 #include "logging.hh"
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <cstdio>
+#include <unistd.h>
 
 namespace Qute {
 
-DependencyManagerWatched::DependencyManagerWatched(QCDCL_solver& solver, string dependency_learning_strategy, string out_of_order_decisions): learnDependenciesPtr(nullptr), solver(solver), prefix_mode(false) {
+static const uint32_t independence_cache_magic = 0x44545551; // "QUTD"
+static const uint32_t independence_cache_version = 1;
+
+DependencyManagerWatched::DependencyManagerWatched(QCDCL_solver& solver, string dependency_learning_strategy, string out_of_order_decisions, string independence_cache_directory): learnDependenciesPtr(nullptr), nr_vars_of_type{0, 0}, independence_cache_directory(independence_cache_directory), solver(solver), prefix_mode(false) {
   if (dependency_learning_strategy == "off") {
     prefix_mode = true;
   } else if (dependency_learning_strategy == "all") {
@@ -53,7 +63,7 @@ void DependencyManagerWatched::learnDependencyWithFewestDependencies(Variable un
   Variable variable_with_fewest_deps = 0;
   for (Literal l : literal_vector) {
     Variable current_var = var(l);
-    uint32_t current_deps = variable_dependencies[current_var - 1].dependent_on.size();
+    uint32_t current_deps = dependent_on.size(current_var - 1);
     if (current_deps < fewest_deps) {
        variable_with_fewest_deps = current_var;
        fewest_deps = current_deps;
@@ -62,19 +72,44 @@ void DependencyManagerWatched::learnDependencyWithFewestDependencies(Variable un
   addDependency(unit_variable, variable_with_fewest_deps);
 }
 
+void DependencyManagerWatched::learnDependencyBatch(vector<pair<Variable, vector<Literal>>>& batch) {
+  for (auto& conflict: batch) {
+    Variable unit_variable = conflict.first;
+    uint64_t dependencies_before = solver.solver_statistics.nr_dependencies;
+    if (++nr_dependency_conflicts[unit_variable - 1] >= dependency_prefetch_threshold) {
+      // A recurring source of conflicts: learn everything recorded for it instead of waiting for the next conflict.
+      for (Variable* it = deferred_dependencies.begin(unit_variable - 1); it != deferred_dependencies.end(unit_variable - 1); ++it) {
+        addDependency(unit_variable, *it);
+      }
+      deferred_dependencies.shrink(unit_variable - 1, 0);
+      solver.solver_statistics.nr_prefetched_dependencies += solver.solver_statistics.nr_dependencies - dependencies_before;
+      learnAllDependencies(unit_variable, conflict.second);
+    } else {
+      learnDependencies(unit_variable, conflict.second);
+      for (Literal l: conflict.second) {
+        if (!dependsOn(unit_variable, var(l))) {
+          deferred_dependencies.push_back(unit_variable - 1, var(l));
+        }
+      }
+    }
+  }
+}
+
 void DependencyManagerWatched::notifyAssigned(Variable v) {
   /* After "variable" is assigned, we must find new watchers for variables that
   were watched by "variable". */
   if (!is_auxiliary[v - 1]) {
-    vector<Variable>::iterator begin, i, j, end;
-    for (begin = i = j = variables_watched_by[v - 1].begin(), end = variables_watched_by[v - 1].end(); i != end; i++) {
-      Variable watched = *i;
+    /* Finding new watchers appends to other lists in the same pool, which may
+    move this one, so it is accessed by index. */
+    uint32_t i, j;
+    for (i = j = 0; i < variables_watched_by.size(v - 1); i++) {
+      Variable watched = variables_watched_by.at(v - 1, i);
       assert(!is_auxiliary[watched - 1]);
       if (!findWatchedDependency(watched, false)) {
         /* If we cannot find a new variable to watch "watched", we keep
         "watched" on the list of variables watched by "variable". */
-        variable_dependencies[watched - 1].watcher_index = j - begin;
-        *j++ = watched;
+        variable_dependencies[watched - 1].watcher_index = j;
+        variables_watched_by.at(v - 1, j++) = watched;
           // Here, we may have to change the state of the VMTF decision heuristic.
         // Variable "watched" is now a decision candidate (unless it is already assigned).
         if (!solver.variable_data_store->isAssigned(watched)) {
@@ -82,7 +117,7 @@ void DependencyManagerWatched::notifyAssigned(Variable v) {
         }
       }
     }
-    variables_watched_by[v - 1].resize(j - begin, 0);
+    variables_watched_by.shrink(v - 1, j);
   }
 }
 
@@ -90,8 +125,11 @@ void DependencyManagerWatched::addDependency(Variable of, Variable on) {
   if (!dependsOn(of, on)) {
     LOG(trace) << "Dependency added: (" << of << ", " << on << ")" << std::endl;
     solver.solver_statistics.nr_dependencies++;
-    variable_dependencies[of - 1].dependent_on.insert(on);
-    variable_dependencies[of - 1].dependent_on_vector.push_back(on);
+    if (solver.heuristic_event_writer) {
+      solver.heuristic_event_writer->dependency(of, on);
+    }
+    dependency_pairs.insert(of, on);
+    dependent_on.push_back(of - 1, on);
     /* If the current watched dependency is 0 or a variable that is assigned,
        make the newly added dependency the new watched dependency. */
     Variable current_watcher = variable_dependencies[of - 1].watcher;
@@ -111,16 +149,17 @@ void DependencyManagerWatched::setWatchedDependency(Variable variable, Variable
     uint32_t index = variable_dependencies[variable - 1].watcher_index;
     Variable current_watcher = variable_dependencies[variable - 1].watcher;
     // Delete "variable" from the list of variables watched by "current_watcher".
-    variables_watched_by[current_watcher - 1][index] = variables_watched_by[current_watcher - 1].back();
-    variables_watched_by[current_watcher - 1].pop_back();
+    uint32_t last_index = variables_watched_by.size(current_watcher - 1) - 1;
+    variables_watched_by.at(current_watcher - 1, index) = variables_watched_by.at(current_watcher - 1, last_index);
+    variables_watched_by.pop_back(current_watcher - 1);
     // Update watched list index of the variable that was moved from the back of the list.
-    Variable moved_watched = variables_watched_by[current_watcher - 1][index];
+    Variable moved_watched = variables_watched_by.at(current_watcher - 1, index);
     variable_dependencies[moved_watched - 1].watcher_index = index;
   }
   // Make "watched" the new watched variable of "variable".
   variable_dependencies[variable - 1].watcher = new_watched;
-  variable_dependencies[variable - 1].watcher_index = variables_watched_by[new_watched - 1].size();
-  variables_watched_by[new_watched - 1].push_back(variable);
+  variable_dependencies[variable - 1].watcher_index = variables_watched_by.size(new_watched - 1);
+  variables_watched_by.push_back(new_watched - 1, variable);
 }
 
 uint32_t DependencyManagerWatched::varAEL(Variable v) {
@@ -154,7 +193,8 @@ bool DependencyManagerWatched::isDecisionCandidate(Variable v) const {
 bool DependencyManagerWatched::findWatchedDependency(Variable variable, bool remove_from_old) {
   /* Go through the vector of variables "variable" depends on. If the corresponding
   variable is unassigned, make it the new watcher. */
-  for (Variable dependency: variable_dependencies[variable - 1].dependent_on_vector) {
+  for (Variable* it = dependent_on.begin(variable - 1); it != dependent_on.end(variable - 1); ++it) {
+    Variable dependency = *it;
     if (!solver.variable_data_store->isAssigned(dependency)) {
       setWatchedDependency(variable, dependency, remove_from_old);
       return true;
@@ -163,6 +203,147 @@ bool DependencyManagerWatched::findWatchedDependency(Variable variable, bool rem
   return false;
 }
 
+/* Adding clauses can only create new resolution paths, so independencies
+ * only ever go away, and only for pairs of variables connected by a path
+ * through an added clause. Both schemes only allow paths whose connecting
+ * (existential) variables lie right of the smaller variable of the pair, so
+ * for every variable we compute the largest possible leftmost connecting
+ * variable over all paths from an added clause to a clause containing it
+ * (a bottleneck path search, deepest literals first). Variables in an added
+ * clause get last_variable + 1, unreached variables 0. */
+vector<Variable> DependencyManagerWatched::addedClausePathDepths() {
+  Variable last_variable = solver.variable_data_store->lastVariable();
+  vector<Variable> variable_depth(last_variable + 1, 0);
+  vector<Variable> landing_depth(2 * last_variable + 2, 0);
+  priority_queue<pair<Variable, int>> landing_literals;
+  auto visitLiteral = [this, &variable_depth, &landing_depth, &landing_literals](Literal l, Variable depth) {
+    variable_depth[var(l)] = std::max(variable_depth[var(l)], depth);
+    Variable connecting_depth = std::min(depth, var(l));
+    if (solver.variable_data_store->varType(var(l)) == 0 && landing_depth[toInt(~l)] < connecting_depth) {
+      landing_depth[toInt(~l)] = connecting_depth;
+      landing_literals.emplace(connecting_depth, toInt(~l));
+    }
+  };
+  for (Literal l: added_clause_literals) {
+    visitLiteral(l, last_variable + 1);
+  }
+  added_clause_literals.clear();
+  while (!landing_literals.empty()) {
+    Variable depth = landing_literals.top().first;
+    Literal current_lit = toLiteral(landing_literals.top().second);
+    landing_literals.pop();
+    if (depth < landing_depth[toInt(current_lit)]) {
+      continue; // already explored over a deeper path
+    }
+    for (auto occit = solver.constraint_database->literalOccurrencesBegin(current_lit, ConstraintType::clauses);
+          occit != solver.constraint_database->literalOccurrencesEnd(current_lit, ConstraintType::clauses);
+          occit++) {
+      for (Literal l: solver.constraint_database->getConstraint(*occit, ConstraintType::clauses)) {
+        if (l != current_lit) {
+          visitLiteral(l, depth);
+        }
+      }
+    }
+  }
+  return variable_depth;
+}
+
+void DependencyManagerWatched::invalidateIndependencies(Variable v) {
+  if (variable_dependencies[v - 1].independencies_known) {
+    variable_dependencies[v - 1].independencies_known = false;
+    variable_dependencies[v - 1].independent_of.clear();
+    solver.solver_statistics.nr_invalidated_independence_sets++;
+  }
+}
+
+/* Hashes the quantifier prefix and the input clauses, which is all that
+ * dependency schemes look at. Clauses are hashed independently of the order
+ * of their literals, which the propagators may have changed. */
+uint64_t DependencyManagerWatched::formulaHash() const {
+  auto mix = [](uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  };
+  uint64_t hash = mix(solver.variable_data_store->lastVariable());
+  for (Variable v = 1; v <= solver.variable_data_store->lastVariable(); v++) {
+    hash = mix(hash ^ solver.variable_data_store->varType(v));
+  }
+  for (auto it = solver.constraint_database->constraintReferencesBegin(ConstraintType::clauses, false);
+       it != solver.constraint_database->constraintReferencesEnd(ConstraintType::clauses, false); ++it) {
+    Constraint& clause = solver.constraint_database->getConstraint(*it, ConstraintType::clauses);
+    uint64_t clause_hash = clause.size();
+    for (Literal l: clause) {
+      clause_hash += mix(toInt(l));
+    }
+    hash = mix(hash ^ clause_hash);
+  }
+  return hash;
+}
+
+string DependencyManagerWatched::independenceCacheFile(const string& scheme) const {
+  std::ostringstream filename;
+  filename << independence_cache_directory << "/" << scheme << "-" << std::hex << std::setw(16) << std::setfill('0') << formulaHash() << ".qdc";
+  return filename.str();
+}
+
+/* A cache file consists of a header (magic, version, number of variables,
+ * number of input clauses, formula hash) followed by the serialized
+ * independence set of every variable. Returns false if the file is missing
+ * or does not match the formula, in which case nothing is changed. */
+bool DependencyManagerWatched::loadIndependencies(const string& filename) {
+  clock_t t = clock();
+  std::ifstream in(filename, std::ios::binary);
+  uint32_t header[6];
+  if (!in.read(reinterpret_cast<char*>(header), sizeof(header))) {
+    return false;
+  }
+  uint64_t hash = formulaHash();
+  uint32_t nr_clauses = solver.constraint_database->constraintReferencesEnd(ConstraintType::clauses, false) -
+                        solver.constraint_database->constraintReferencesBegin(ConstraintType::clauses, false);
+  if (header[0] != independence_cache_magic || header[1] != independence_cache_version ||
+      header[2] != static_cast<uint32_t>(solver.variable_data_store->lastVariable()) || header[3] != nr_clauses ||
+      header[4] != static_cast<uint32_t>(hash) || header[5] != static_cast<uint32_t>(hash >> 32)) {
+    return false;
+  }
+  vector<IndependenceSet> independencies(header[2]);
+  for (auto& independence_set: independencies) {
+    if (!independence_set.read(in)) {
+      return false;
+    }
+  }
+  for (Variable v = 1; v <= solver.variable_data_store->lastVariable(); v++) {
+    variable_dependencies[v - 1].independent_of = std::move(independencies[v - 1]);
+    variable_dependencies[v - 1].independencies_known = true;
+    solver.solver_statistics.nr_independencies += variable_dependencies[v - 1].independent_of.size();
+  }
+  solver.solver_statistics.time_spent_computing_depscheme += clock() - t;
+  return true;
+}
+
+// Expects the independencies of all variables to be known.
+void DependencyManagerWatched::saveIndependencies(const string& filename) const {
+  // Write to a temporary file first so that concurrent runs never see a partial cache.
+  string temporary_filename = filename + ".tmp" + std::to_string(getpid());
+  std::ofstream out(temporary_filename, std::ios::binary);
+  uint64_t hash = formulaHash();
+  uint32_t nr_clauses = solver.constraint_database->constraintReferencesEnd(ConstraintType::clauses, false) -
+                        solver.constraint_database->constraintReferencesBegin(ConstraintType::clauses, false);
+  uint32_t header[6] = {independence_cache_magic, independence_cache_version, static_cast<uint32_t>(solver.variable_data_store->lastVariable()),
+                        nr_clauses, static_cast<uint32_t>(hash), static_cast<uint32_t>(hash >> 32)};
+  out.write(reinterpret_cast<const char*>(header), sizeof(header));
+  for (Variable v = 1; v <= solver.variable_data_store->lastVariable(); v++) {
+    variable_dependencies[v - 1].independent_of.write(out);
+  }
+  out.close();
+  if (!out || std::rename(temporary_filename.c_str(), filename.c_str()) != 0) {
+    std::remove(temporary_filename.c_str());
+    std::cerr << "qute: cannot write depscheme cache '" << filename << "'\n";
+  }
+}
+
 // TODO: use MiniSAT::Heap to store AET and perform setVariableAEL and markPermanentlyUnassignable faster
 void DependencyManagerWatched::markVarPermanentlyUnassignable(Variable v) {
   /* mark only, removal from AET takes place upon backtracking if necessary
@@ -230,7 +411,7 @@ inline bool DependencyManagerWatched::dependsOn(Variable of, Variable on) const
   if (prefix_mode) {
     return on < of && solver.variable_data_store->varType(of) != solver.variable_data_store->varType(on);
   } else {
-    return variable_dependencies[of - 1].dependent_on.find(on) != variable_dependencies[of - 1].dependent_on.end();
+    return dependency_pairs.contains(of, on);
   }
 }
 
@@ -2,13 +2,18 @@
 #define dependency_manager_watched_hh
 
 #include "dependency_manager.hh"
+#include "independence_set.hh"
+#include "dependency_storage.hh"
 #include <vector>
 #include <queue>
+#include <utility>
 #include <unordered_set>
 #include <string>
 #include <cstring>
 
 using std::vector;
+using std::priority_queue;
+using std::pair;
 using std::unordered_set;
 using std::string;
 
@@ -26,8 +31,9 @@ friend class DecisionHeuristicVSIDSdeplearn;
 friend class DecisionHeuristicSGDB;
 
 public:
-  DependencyManagerWatched(QCDCL_solver& solver, string dependency_learning_strategy, string out_of_order_decisions);
+  DependencyManagerWatched(QCDCL_solver& solver, string dependency_learning_strategy, string out_of_order_decisions, string independence_cache_directory = "");
   virtual void addVariable(bool auxiliary, bool qtype);
+  virtual void notifyMaxVarDeclaration(Variable max_var);
   virtual void addDependency(Variable of, Variable on);
   virtual void notifyStart();
   virtual void notifyAssigned(Variable v);
@@ -35,6 +41,10 @@ public:
   virtual bool isDecisionCandidate(Variable v) const;
   virtual bool dependsOn(Variable of, Variable on) const;
   virtual void learnDependencies(Variable unit_variable, vector<Literal>& literal_vector);
+  /* Learns the dependencies of all illegal merges of one conflict analysis. Blocking variables
+   * the learning strategy passes over are remembered, and learned as soon as the same variable
+   * causes another dependency conflict. */
+  void learnDependencyBatch(vector<pair<Variable, vector<Literal>>>& batch);
 
   // these methods only do something when a dependency scheme is turned on
   virtual void reduceWithDepscheme(std::vector<bool>& characteristic_function, Literal& rightmost_primary, ConstraintType constraint_type) {};
@@ -56,7 +66,15 @@ protected:
   void learnOutermostDependency(Variable unit_variable, vector<Literal>& literal_vector);
   void learnDependencyWithFewestDependencies(Variable unit_variable, vector<Literal>& literal_vector);
   Variable watcher(Variable v) const;
+  uint32_t indexInType(Variable v) const;
+  bool sameType(Variable v, Variable w) const;
   bool findWatchedDependency(Variable v, bool remove_from_old);
+  vector<Variable> addedClausePathDepths();
+  void invalidateIndependencies(Variable v);
+  uint64_t formulaHash() const;
+  string independenceCacheFile(const string& scheme) const;
+  bool loadIndependencies(const string& filename);
+  void saveIndependencies(const string& filename) const;
   void setWatchedDependency(Variable variable, Variable new_watched, bool remove_from_old);
 
   struct DependencyData
@@ -64,14 +82,27 @@ protected:
     Variable watcher;
     uint32_t watcher_index:31;
     bool independencies_known:1;
-    unordered_set<Variable> dependent_on;
-    vector<Variable> dependent_on_vector;
-    vector<Variable> independent_of;
-    DependencyData(): watcher(0), watcher_index(0), independencies_known(false) {};
+    uint32_t index_in_type:31;
+    bool qtype:1;
+    IndependenceSet independent_of;
+    DependencyData(uint32_t index_in_type, bool qtype): watcher(0), watcher_index(0), independencies_known(false), index_in_type(index_in_type), qtype(qtype) {};
   };
 
   vector<DependencyData> variable_dependencies;
-  vector<vector<Variable>> variables_watched_by;
+  // List v - 1 holds the variables v depends on, in the order the dependencies were added.
+  VariableListPool dependent_on;
+  // Pairs (of, on) of dependencies, for constant-time dependsOn.
+  VariablePairSet dependency_pairs;
+  VariableListPool variables_watched_by;
+  // Blocking variables of earlier dependency conflicts that were not learned, only used by learnDependencyBatch.
+  VariableListPool deferred_dependencies;
+  vector<uint32_t> nr_dependency_conflicts;
+  static const uint32_t dependency_prefetch_threshold = 2;
+  uint32_t nr_vars_of_type[2];
+  // Literals of input clauses added during search whose effect on the dependency scheme is pending.
+  vector<Literal> added_clause_literals;
+  // Independencies are stored here across runs, keyed by a hash of the formula (empty: no caching).
+  string independence_cache_directory;
 
   QCDCL_solver& solver;
   bool prefix_mode;
@@ -92,9 +123,21 @@ protected:
 
 // Implementation of inline methods.
 
+inline void DependencyManagerWatched::notifyMaxVarDeclaration(Variable max_var) {
+  variables_watched_by.reserve(max_var);
+  deferred_dependencies.reserve(max_var);
+  dependent_on.reserve(max_var);
+  variable_dependencies.reserve(max_var);
+  is_auxiliary.reserve(max_var);
+  AEL.reserve(max_var);
+}
+
 inline void DependencyManagerWatched::addVariable(bool auxiliary, bool qtype) {
-  variables_watched_by.emplace_back();
-  variable_dependencies.emplace_back();
+  variables_watched_by.addList();
+  deferred_dependencies.addList();
+  nr_dependency_conflicts.push_back(0);
+  dependent_on.addList();
+  variable_dependencies.emplace_back(nr_vars_of_type[qtype]++, qtype);
   is_auxiliary.push_back(auxiliary);
   if (!auxiliary) {
     if (out_of_order_decisions[qtype]) {
@@ -115,6 +158,14 @@ inline Variable DependencyManagerWatched::watcher(Variable v) const {
   return variable_dependencies[v - 1].watcher;
 }
 
+inline uint32_t DependencyManagerWatched::indexInType(Variable v) const {
+  return variable_dependencies[v - 1].index_in_type;
+}
+
+inline bool DependencyManagerWatched::sameType(Variable v, Variable w) const {
+  return variable_dependencies[v - 1].qtype == variable_dependencies[w - 1].qtype;
+}
+
 }
 
 #endif
@@ -0,0 +1,206 @@
+#ifndef dependency_storage_hh
+#define dependency_storage_hh
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "solver_types.hh"
+
+using std::vector;
+
+namespace Qute {
+
+/* A collection of growable lists of variables sharing a single arena. Lists
+ * of up to two variables are stored inline in their header, longer lists in
+ * the arena; a list that outgrows its slot moves to the end of the arena, and
+ * the arena is compacted once more than half of it is unused. Pointers into
+ * the arena are therefore invalidated by push_back on any list. */
+class VariableListPool {
+
+public:
+  VariableListPool(): wasted(0) {}
+  void reserve(uint32_t nr_lists);
+  // Appends a new empty list, lists are numbered consecutively from 0.
+  void addList();
+  uint32_t size(uint32_t list) const;
+  Variable* begin(uint32_t list);
+  Variable* end(uint32_t list);
+  Variable& at(uint32_t list, uint32_t index);
+  void push_back(uint32_t list, Variable v);
+  void pop_back(uint32_t list);
+  void shrink(uint32_t list, uint32_t new_size);
+
+protected:
+  static const uint32_t inline_capacity = 2;
+  struct ListHeader {
+    uint32_t size;
+    uint32_t capacity;
+    union {
+      Variable items[inline_capacity];
+      uint32_t offset;
+    };
+    ListHeader(): size(0), capacity(inline_capacity) {}
+  };
+  void grow(ListHeader& header);
+  void compact();
+
+  vector<ListHeader> lists;
+  vector<Variable> arena;
+  uint32_t wasted;
+
+};
+
+/* A set of pairs of variables in a single open-addressing hash table with
+ * linear probing, kept at most half full. */
+class VariablePairSet {
+
+public:
+  VariablePairSet(): nr_pairs(0) {}
+  bool contains(Variable first, Variable second) const;
+  // Returns whether the pair was not yet contained.
+  bool insert(Variable first, Variable second);
+
+protected:
+  static uint64_t key(Variable first, Variable second);
+  static size_t hash(uint64_t key);
+  void rehash(size_t nr_slots);
+
+  vector<uint64_t> slots; // 0 marks an empty slot, variables start at 1
+  size_t nr_pairs;
+
+};
+
+// Implementation of inline methods.
+
+inline void VariableListPool::reserve(uint32_t nr_lists) {
+  lists.reserve(nr_lists);
+}
+
+inline void VariableListPool::addList() {
+  lists.emplace_back();
+}
+
+inline uint32_t VariableListPool::size(uint32_t list) const {
+  return lists[list].size;
+}
+
+inline Variable* VariableListPool::begin(uint32_t list) {
+  ListHeader& header = lists[list];
+  return header.capacity == inline_capacity ? header.items : arena.data() + header.offset;
+}
+
+inline Variable* VariableListPool::end(uint32_t list) {
+  return begin(list) + lists[list].size;
+}
+
+inline Variable& VariableListPool::at(uint32_t list, uint32_t index) {
+  return begin(list)[index];
+}
+
+inline void VariableListPool::push_back(uint32_t list, Variable v) {
+  ListHeader& header = lists[list];
+  if (header.size == header.capacity) {
+    grow(header);
+  }
+  begin(list)[lists[list].size++] = v;
+}
+
+inline void VariableListPool::pop_back(uint32_t list) {
+  lists[list].size--;
+}
+
+inline void VariableListPool::shrink(uint32_t list, uint32_t new_size) {
+  lists[list].size = new_size;
+}
+
+inline void VariableListPool::grow(ListHeader& header) {
+  uint32_t new_capacity = 2 * header.capacity;
+  uint32_t new_offset = arena.size();
+  arena.resize(arena.size() + new_capacity);
+  Variable* old_items = header.capacity == inline_capacity ? header.items : arena.data() + header.offset;
+  std::memmove(arena.data() + new_offset, old_items, header.size * sizeof(Variable));
+  if (header.capacity != inline_capacity) {
+    wasted += header.capacity;
+  }
+  header.capacity = new_capacity;
+  header.offset = new_offset;
+  if (wasted > arena.size() / 2) {
+    compact();
+  }
+}
+
+inline void VariableListPool::compact() {
+  vector<Variable> compacted;
+  compacted.reserve(arena.size() - wasted);
+  for (ListHeader& header: lists) {
+    if (header.capacity != inline_capacity) {
+      uint32_t new_offset = compacted.size();
+      compacted.insert(compacted.end(), arena.begin() + header.offset, arena.begin() + header.offset + header.size);
+      compacted.resize(new_offset + header.capacity);
+      header.offset = new_offset;
+    }
+  }
+  arena.swap(compacted);
+  wasted = 0;
+}
+
+inline uint64_t VariablePairSet::key(Variable first, Variable second) {
+  return (static_cast<uint64_t>(first) << 32) | static_cast<uint32_t>(second);
+}
+
+inline size_t VariablePairSet::hash(uint64_t key) {
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdULL;
+  key ^= key >> 33;
+  return key;
+}
+
+inline bool VariablePairSet::contains(Variable first, Variable second) const {
+  if (slots.empty()) {
+    return false;
+  }
+  uint64_t pair_key = key(first, second);
+  size_t mask = slots.size() - 1;
+  for (size_t i = hash(pair_key) & mask; slots[i] != 0; i = (i + 1) & mask) {
+    if (slots[i] == pair_key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline bool VariablePairSet::insert(Variable first, Variable second) {
+  if (2 * (nr_pairs + 1) > slots.size()) {
+    rehash(slots.empty() ? 16 : 2 * slots.size());
+  }
+  uint64_t pair_key = key(first, second);
+  size_t mask = slots.size() - 1;
+  size_t i = hash(pair_key) & mask;
+  for (; slots[i] != 0; i = (i + 1) & mask) {
+    if (slots[i] == pair_key) {
+      return false;
+    }
+  }
+  slots[i] = pair_key;
+  nr_pairs++;
+  return true;
+}
+
+inline void VariablePairSet::rehash(size_t nr_slots) {
+  vector<uint64_t> old_slots(nr_slots, 0);
+  old_slots.swap(slots);
+  size_t mask = slots.size() - 1;
+  for (uint64_t pair_key: old_slots) {
+    if (pair_key != 0) {
+      size_t i = hash(pair_key) & mask;
+      while (slots[i] != 0) {
+        i = (i + 1) & mask;
+      }
+      slots[i] = pair_key;
+    }
+  }
+}
+
+}
+
+#endif
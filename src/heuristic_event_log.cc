@@ -0,0 +1,84 @@
+#include "heuristic_event_log.hh"
+
+#include <iostream>
+
+namespace Qute {
+
+static const uint32_t heuristic_event_log_magic = 0x48545551; // "QUTH"
+static const uint32_t heuristic_event_log_version = 1;
+
+static const string error_header = "qute error: ";
+
+bool HeuristicEventWriter::open(const string& filename, uint32_t flags) {
+  ofs.open(filename, std::ios::binary | std::ios::trunc);
+  if (!ofs.is_open()) {
+    return false;
+  }
+  header = {heuristic_event_log_magic, heuristic_event_log_version, flags, 0};
+  // The number of variables is only known at the end, the header is rewritten by close.
+  ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  buffer.reserve(buffer_size);
+  is_open = true;
+  return ofs.good();
+}
+
+void HeuristicEventWriter::learned(Constraint& constraint, ConstraintType constraint_type, vector<Literal>& conflict_side_literals) {
+  event(event_learned, constraint_type);
+  put(constraint.size());
+  for (Literal l: constraint) {
+    put(toInt(l));
+  }
+  put(conflict_side_literals.size());
+  for (Literal l: conflict_side_literals) {
+    put(toInt(l));
+  }
+}
+
+void HeuristicEventWriter::flush() {
+  if (is_open) {
+    ofs.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(uint32_t));
+  }
+  buffer.clear();
+}
+
+bool HeuristicEventWriter::close(uint32_t nr_variables) {
+  if (!is_open) {
+    return false;
+  }
+  flush();
+  header.nr_variables = nr_variables;
+  ofs.seekp(0);
+  ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  ofs.close();
+  is_open = false;
+  return !ofs.fail();
+}
+
+static void corrupt_log_error(const string& filename) {
+  std::cerr << error_header << "Corrupt heuristic event log '" << filename << "'" << std::endl;
+  exit(1);
+}
+
+void readHeuristicEventLog(const string& filename, HeuristicEventLogHeader& header, vector<uint32_t>& events) {
+  std::ifstream ifs(filename, std::ios::binary | std::ios::ate);
+  if (!ifs.is_open()) {
+    std::cerr << error_header << "Cannot open heuristic event log '" << filename << "'" << std::endl;
+    exit(1);
+  }
+  size_t file_size = ifs.tellg();
+  if (file_size < sizeof(header) || (file_size - sizeof(header)) % sizeof(uint32_t) != 0) {
+    corrupt_log_error(filename);
+  }
+  ifs.seekg(0);
+  ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (header.magic != heuristic_event_log_magic || header.version != heuristic_event_log_version) {
+    corrupt_log_error(filename);
+  }
+  events.resize((file_size - sizeof(header)) / sizeof(uint32_t));
+  ifs.read(reinterpret_cast<char*>(events.data()), events.size() * sizeof(uint32_t));
+  if (!ifs.good()) {
+    corrupt_log_error(filename);
+  }
+}
+
+}
@@ -0,0 +1,120 @@
+#ifndef heuristic_event_log_hh
+#define heuristic_event_log_hh
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include "constraint.hh"
+#include "solver_types.hh"
+
+using std::string;
+using std::vector;
+
+namespace Qute {
+
+/* A heuristic event log records what a decision heuristic was told and asked
+ * during a solver run, so that the run can be replayed against any heuristic
+ * without propagation or conflict analysis (see qute_bench.cc).
+ *
+ * The log is a sequence of native-endian 32-bit words:
+ *   header (see HeuristicEventLogHeader)
+ *   events: a word (payload << 3 | event type), where the payload is a literal,
+ *           a decision level or a constraint type, followed by further words
+ *           for learned constraints (size, literals, number of conflict side
+ *           literals, conflict side literals) and dependencies (the variable
+ *           depended on)
+ */
+enum HeuristicEvent: uint32_t {
+  event_decision_assigned,
+  event_propagation_assigned,
+  event_unassigned,
+  event_backtrack,
+  event_decision,
+  event_conflict,
+  event_learned,
+  event_dependency
+};
+
+struct HeuristicEventLogHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t flags;
+  uint32_t nr_variables;
+};
+
+// Flags describing the run that was recorded, the replay must set up the solver the same way.
+static const uint32_t heuristic_event_log_model_generation = 1 << 0;
+static const uint32_t heuristic_event_log_prefix_mode = 1 << 1;
+
+class HeuristicEventWriter {
+
+public:
+  HeuristicEventWriter(): is_open(false) {}
+  bool open(const string& filename, uint32_t flags);
+  void assigned(Literal l, bool decision);
+  void unassigned(Literal l);
+  void backtrack(uint32_t decision_level_before);
+  void decision(Literal l);
+  void conflict(ConstraintType constraint_type);
+  void learned(Constraint& constraint, ConstraintType constraint_type, vector<Literal>& conflict_side_literals);
+  void dependency(Variable of, Variable on);
+  // Writes buffered events and the final number of variables, returns false if anything could not be written.
+  bool close(uint32_t nr_variables);
+
+protected:
+  void event(HeuristicEvent type, uint32_t payload);
+  void put(uint32_t word);
+  void flush();
+
+  static const size_t buffer_size = 1 << 16;
+  std::ofstream ofs;
+  HeuristicEventLogHeader header;
+  vector<uint32_t> buffer;
+  bool is_open;
+
+};
+
+// Reads a whole log into memory, exits with an error message if it is not a valid log.
+void readHeuristicEventLog(const string& filename, HeuristicEventLogHeader& header, vector<uint32_t>& events);
+
+// Implementation of inline methods.
+
+inline void HeuristicEventWriter::put(uint32_t word) {
+  buffer.push_back(word);
+  if (buffer.size() == buffer_size) {
+    flush();
+  }
+}
+
+inline void HeuristicEventWriter::event(HeuristicEvent type, uint32_t payload) {
+  put((payload << 3) | type);
+}
+
+inline void HeuristicEventWriter::assigned(Literal l, bool decision) {
+  event(decision ? event_decision_assigned : event_propagation_assigned, toInt(l));
+}
+
+inline void HeuristicEventWriter::unassigned(Literal l) {
+  event(event_unassigned, toInt(l));
+}
+
+inline void HeuristicEventWriter::backtrack(uint32_t decision_level_before) {
+  event(event_backtrack, decision_level_before);
+}
+
+inline void HeuristicEventWriter::decision(Literal l) {
+  event(event_decision, toInt(l));
+}
+
+inline void HeuristicEventWriter::conflict(ConstraintType constraint_type) {
+  event(event_conflict, constraint_type);
+}
+
+inline void HeuristicEventWriter::dependency(Variable of, Variable on) {
+  event(event_dependency, of);
+  put(on);
+}
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+#include "independence_set.hh"
+
+namespace Qute {
+
+/* Layout: (dense, first_index, nr_members, leftmost_variable, payload size)
+ * followed by the bitset words or the sorted indices. */
+void IndependenceSet::write(std::ostream& out) const {
+  uint32_t header[5] = {dense, first_index, nr_members, static_cast<uint32_t>(leftmost_variable),
+                        static_cast<uint32_t>(dense ? bits.size() : sorted_indices.size())};
+  out.write(reinterpret_cast<const char*>(header), sizeof(header));
+  if (dense) {
+    out.write(reinterpret_cast<const char*>(bits.data()), bits.size() * sizeof(uint64_t));
+  } else {
+    out.write(reinterpret_cast<const char*>(sorted_indices.data()), sorted_indices.size() * sizeof(uint32_t));
+  }
+}
+
+bool IndependenceSet::read(std::istream& in) {
+  uint32_t header[5];
+  if (!in.read(reinterpret_cast<char*>(header), sizeof(header)) || header[0] > 1) {
+    return false;
+  }
+  dense = header[0];
+  first_index = header[1];
+  nr_members = header[2];
+  leftmost_variable = header[3];
+  if (dense) {
+    sorted_indices.clear();
+    // A dense set never takes more words than it has members.
+    if (header[4] > nr_members) {
+      return false;
+    }
+    bits.resize(header[4]);
+    in.read(reinterpret_cast<char*>(bits.data()), bits.size() * sizeof(uint64_t));
+  } else {
+    bits.clear();
+    if (header[4] != nr_members) {
+      return false;
+    }
+    sorted_indices.resize(header[4]);
+    in.read(reinterpret_cast<char*>(sorted_indices.data()), sorted_indices.size() * sizeof(uint32_t));
+  }
+  return static_cast<bool>(in);
+}
+
+}
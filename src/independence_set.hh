@@ -0,0 +1,125 @@
+#ifndef independence_set_hh
+#define independence_set_hh
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include "solver_types.hh"
+
+using std::vector;
+
+namespace Qute {
+
+/* The independencies a dependency scheme found for one variable. Members are
+ * always of the quantifier type opposite to the owning variable, so they are
+ * addressed by their index among the variables of that type. Sets covering a
+ * range densely enough are stored as a bitset over the indices between the
+ * smallest and largest member, sparse sets as a sorted vector of indices. */
+class IndependenceSet {
+
+public:
+  IndependenceSet(): dense(false), first_index(0), nr_members(0), leftmost_variable(0) {}
+  // Replaces the set by sorted_variables, index_of maps a variable to its index.
+  template <typename IndexOf> void assign(const vector<Variable>& sorted_variables, IndexOf index_of);
+  void clear();
+  bool contains(uint32_t index) const;
+  uint32_t size() const;
+  Variable leftmost() const;
+  // Binary (de)serialization of the stored representation, as native-endian words.
+  void write(std::ostream& out) const;
+  bool read(std::istream& in);
+
+  /* Answers membership queries that arrive in non-increasing order of index
+   * by walking backwards over the sorted members, so a batch of queries costs
+   * at most one pass over the set. */
+  class DescendingLookup {
+  public:
+    DescendingLookup(const IndependenceSet& set): set(&set), position(set.sorted_indices.size()) {}
+    bool contains(uint32_t index);
+  private:
+    const IndependenceSet* set;
+    size_t position;
+  };
+
+protected:
+  bool dense;
+  uint32_t first_index;
+  uint32_t nr_members;
+  Variable leftmost_variable;
+  vector<uint64_t> bits;
+  vector<uint32_t> sorted_indices;
+
+};
+
+// Implementation of inline methods.
+
+template <typename IndexOf> void IndependenceSet::assign(const vector<Variable>& sorted_variables, IndexOf index_of) {
+  bits.clear();
+  sorted_indices.clear();
+  nr_members = sorted_variables.size();
+  dense = false;
+  if (sorted_variables.empty()) {
+    first_index = 0;
+    leftmost_variable = 0;
+    return;
+  }
+  leftmost_variable = sorted_variables.front();
+  first_index = index_of(sorted_variables.front());
+  uint32_t nr_words = (index_of(sorted_variables.back()) - first_index) / 64 + 1;
+  // A word holds 64 members but costs as much as two entries of the sorted vector.
+  dense = nr_words <= nr_members;
+  if (dense) {
+    bits.assign(nr_words, 0);
+    for (Variable v: sorted_variables) {
+      uint32_t offset = index_of(v) - first_index;
+      bits[offset / 64] |= uint64_t(1) << (offset % 64);
+    }
+  } else {
+    sorted_indices.reserve(nr_members);
+    for (Variable v: sorted_variables) {
+      sorted_indices.push_back(index_of(v));
+    }
+  }
+}
+
+inline void IndependenceSet::clear() {
+  vector<uint64_t>().swap(bits);
+  vector<uint32_t>().swap(sorted_indices);
+  dense = false;
+  first_index = 0;
+  nr_members = 0;
+  leftmost_variable = 0;
+}
+
+inline bool IndependenceSet::contains(uint32_t index) const {
+  if (dense) {
+    uint32_t offset = index - first_index;
+    return index >= first_index && offset / 64 < bits.size() && ((bits[offset / 64] >> (offset % 64)) & 1);
+  } else {
+    return std::binary_search(sorted_indices.begin(), sorted_indices.end(), index);
+  }
+}
+
+inline uint32_t IndependenceSet::size() const {
+  return nr_members;
+}
+
+inline Variable IndependenceSet::leftmost() const {
+  return leftmost_variable;
+}
+
+inline bool IndependenceSet::DescendingLookup::contains(uint32_t index) {
+  if (set->dense) {
+    return set->contains(index);
+  }
+  while (position > 0 && set->sorted_indices[position - 1] > index) {
+    position--;
+  }
+  return position > 0 && set->sorted_indices[position - 1] == index;
+}
+
+}
+
+#endif
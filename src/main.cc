@@ -3,6 +3,7 @@
 #include <iostream>
 #include <string>
 #include "main.hh"
+#include "binary_image.hh"
 #include "external_propagator.hh"
 #include "logging.hh"
 #include "simple_tracer.hh"
@@ -14,7 +15,10 @@
 #include "decision_heuristic_VMTF_deplearn.hh"
 #include "decision_heuristic_VMTF_prefix.hh"
 #include "decision_heuristic_VSIDS_deplearn.hh"
+#include "decision_heuristic_VSIDS_prefix.hh"
 #include "decision_heuristic_SGDB.hh"
+#include "decision_heuristic_recorder.hh"
+#include "decision_heuristic_mode_switch.hh"
 #include "dependency_manager_rrs.hh"
 #include "dependency_manager_upure.hh"
 #include "model_generator_simple.hh"
@@ -23,6 +27,7 @@
 #include "restart_scheduler_inner_outer.hh"
 #include "restart_scheduler_ema.hh"
 #include "restart_scheduler_luby.hh"
+#include "restart_scheduler_mode_switch.hh"
 #include "standard_learning_engine.hh"
 #include "variable_data.hh"
 #include "three_watched_literal_propagator.hh"
@@ -64,6 +69,8 @@ General Options:
                                         (off | depqbf | weighted)
   --dependency-learning arg             dependency learning strategy
                                         (off | outermost | fewest | all) [default: all]
+  --dependency-learning-batch           learn the dependencies of all illegal merges of a conflict
+                                        analysis and backtrack once
   --watched-literals <int>              watched-literals scheme (out-of-order decisions require 3)
                                         (2 | 3) [default: 2]
   --out-of-order-decisions arg          decisions should not respect dependencies [default: off]
@@ -71,15 +78,29 @@ General Options:
   --depscheme arg                       use a dependency scheme to resolve dependency conflicts
                                         (off | rrs | upure) [default: off]
   --depscheme-term-learning-unsafe      use the selected dependency scheme for term learning (soundness unknown) 
+  --depscheme-precompute                compute the dependency scheme for all variables before search (rrs only)
+  --depscheme-threads <int>             number of threads for --depscheme-precompute, 0 for one per core [default: 0]
+  --depscheme-backend arg               reachability computation used by rrs [default: queue]
+                                        (queue | bitparallel)
+  --depscheme-cache <string>            load independencies from this directory, or compute them for
+                                        all variables before search and store them there
   --no-phase-saving                     deactivate phase saving
   --phase-heuristic arg                 phase selection heuristic [default: watcher]
                                         (invJW, qtype, watcher, random, false, true) 
+  --target-phases arg                   decide variables of these types with the phases of the longest
+                                        conflict-free trail (off | existential | universal | all) [default: off]
+  --rephase-interval <int>              restarts until the saved phases of variables with target phases
+                                        are reset, growing arithmetically, 0 for never [default: 20]
   --partial-certificate                 output assignment to outermost block
   -v --verbose                          output information during solver run
   --print-stats                         print statistics on termination
   --machine-readable                    print a comma-separated CSV line with full stats instead of just answer
   --machine-readable-header             print a header line for --machine-readable
   --trace <string>                      output solver trace for certificate generation into this file
+  --dump-binary <string>                write the parsed formula as a binary image into this file
+                                        (a binary image can be given as <path> instead of the formula)
+  --record-heuristic-events <string>    record the events seen by the decision heuristic into this file
+                                        (replay them with qute-bench)
   -t --time-limit <double>              tell the solver to give up after this much time (in seconds) [default: 1e52]
 
 Weighted Model Generation Options:
@@ -87,11 +108,16 @@ Weighted Model Generation Options:
   --scaling-factor <double>             scaling factor for variable weights [default: 1]
   --universal-penalty <double>          additive penalty for universal variables [default: 0]
 
+VMTF Options:
+  --bump-conflict-side                  also move the variables resolved on in conflict analysis to the front
+
 VSIDS Options:
   --tiebreak arg                        tiebreaking strategy for equally active variables [default: arbitrary]
                                         (arbitrary, more-primary, fewer-primary, more-secondary, fewer-secondary)
   --var-activity-inc <double>           variable activity increment [default: 1]
   --var-activity-decay <double>         variable activity decay [default: 0.95]
+  --vsids-queue arg                     priority queue of variables, buckets orders them by activity only up to 19%
+                                        (heap, buckets) [default: heap]
 
 SGDB Options:
   --initial-learning-rate <double>      Initial learning rate [default: 0.8]
@@ -106,12 +132,26 @@ EMA Restart Options:
   --alpha <double>                      Weight of new constraint LBD [default: 2e-5]
   --minimum-distance <int>              Minimum restart distance [default: 20]
   --threshold-factor <double>           Restart if short term LBD is this much larger than long term LBD [default: 1.4]
+  --term-threshold-factor <double>      Threshold factor for the LBD of learned terms [default: 1.4]
+  --ema-signal arg                      Compare LBD averages of the type just learned, or average both
+                                        types relative to their thresholds (learned | combined) [default: learned]
+  --blocking-factor <double>            Block restarts while the trail is this much longer than its average,
+                                        0 for never [default: 0]
 
 Outer-Inner Restart Options:
   --inner-restart-distance <int>        initial number of conflicts until inner restart [default: 100]
   --outer-restart-distance <int>        initial number of conflicts until outer restart [default: 100]
   --restart-multiplier <double>         restart limit multiplier [default: 1.1]
 
+Mode Switching Options:
+  --mode-switching                      alternate between a focused mode, using --decision-heuristic and --restarts,
+                                        and a stable mode with Luby restarts
+  --stable-decision-heuristic arg       variable decision heuristic in stable mode [default: VSIDS]
+                                        (VSIDS | VMTF | SGDB)
+  --stable-luby-multiplier <int>        multiplier for Luby restart intervals in stable mode [default: 1024]
+  --mode-switch-interval <int>          number of conflicts until the first switch to stable mode [default: 1000]
+  --mode-switch-multiplier <double>     each mode lasts this many times as long as the one before [default: 2]
+
 SMS Options:
   --sms-vertices <int>                  search for graphs with this many vertices [default: 2]
   --sms-cutoff <int>                    cutoff limit for SMS's minimality check [default: 0]
@@ -119,6 +159,85 @@ SMS Options:
 
 )";
 
+static unique_ptr<DecisionHeuristic> makeDecisionHeuristic(map<string, docopt::value>& args, const string& name) {
+  unique_ptr<DecisionHeuristic> decision_heuristic;
+  if (args["--dependency-learning"].asString() == "off" && name == "VSIDS") {
+    decision_heuristic = make_unique<DecisionHeuristicVSIDSprefix>(*solver,
+                                                            args["--no-phase-saving"].asBool(),
+                                                            std::stod(args["--var-activity-decay"].asString()),
+                                                            std::stod(args["--var-activity-inc"].asString()));
+  } else if (args["--dependency-learning"].asString() == "off") {
+    decision_heuristic = make_unique<DecisionHeuristicVMTFprefix>(*solver, args["--no-phase-saving"].asBool());
+  } else if (name == "VMTF") {
+    decision_heuristic = make_unique<DecisionHeuristicVMTFdeplearn>(*solver, args["--no-phase-saving"].asBool(), args["--bump-conflict-side"].asBool());
+  } else if (name == "VSIDS") {
+    bool tiebreak_scores = false;
+    bool use_secondary_occurrences = false;
+    bool prefer_fewer_occurrences = false;
+    if (args["--tiebreak"].asString() == "arbitrary") {
+      tiebreak_scores = false;
+    } else if (args["--tiebreak"].asString() == "more-primary") {
+      tiebreak_scores = true;
+      use_secondary_occurrences = false;
+      prefer_fewer_occurrences = false;
+    } else if (args["--tiebreak"].asString() == "fewer-primary") {
+      tiebreak_scores = true;
+      use_secondary_occurrences = false;
+      prefer_fewer_occurrences = true;
+    } else if (args["--tiebreak"].asString() == "more-secondary") {
+      tiebreak_scores = true;
+      use_secondary_occurrences = true;
+      prefer_fewer_occurrences = false;
+    } else if (args["--tiebreak"].asString() == "fewer-secondary") {
+      tiebreak_scores = true;
+      use_secondary_occurrences = true;
+      prefer_fewer_occurrences = true;
+    } else {
+      assert(false);
+    }
+    decision_heuristic = make_unique<DecisionHeuristicVSIDSdeplearn>(*solver,
+                                                            args["--no-phase-saving"].asBool(),
+                                                            std::stod(args["--var-activity-decay"].asString()),
+                                                            std::stod(args["--var-activity-inc"].asString()),
+                                                            tiebreak_scores,
+                                                            use_secondary_occurrences,
+                                                            prefer_fewer_occurrences,
+                                                            args["--vsids-queue"].asString() == "buckets");
+  } else if (name == "SGDB") {
+    decision_heuristic = make_unique<DecisionHeuristicSGDB>(*solver,
+                                                    args["--no-phase-saving"].asBool(),
+                                                    std::stod(args["--initial-learning-rate"].asString()),
+                                                    std::stod(args["--learning-rate-decay"].asString()),
+                                                    std::stod(args["--learning-rate-minimum"].asString()),
+                                                    std::stod(args["--lambda-factor"].asString()));
+  } else {
+    assert(false);
+  }
+
+  DecisionHeuristic::PhaseHeuristicOption phase_heuristic = DecisionHeuristic::PhaseHeuristicOption::PHFALSE;
+  if (args["--phase-heuristic"].asString() == "qtype") {
+    phase_heuristic = DecisionHeuristic::PhaseHeuristicOption::QTYPE;
+  } else if (args["--phase-heuristic"].asString() == "watcher") {
+    phase_heuristic = DecisionHeuristic::PhaseHeuristicOption::WATCHER;
+  } else if (args["--phase-heuristic"].asString() == "random") {
+    phase_heuristic = DecisionHeuristic::PhaseHeuristicOption::RANDOM;
+  } else if (args["--phase-heuristic"].asString() == "false") {
+    phase_heuristic = DecisionHeuristic::PhaseHeuristicOption::PHFALSE;
+  } else if (args["--phase-heuristic"].asString() == "true") {
+    phase_heuristic = DecisionHeuristic::PhaseHeuristicOption::PHTRUE;
+  } else if (args["--phase-heuristic"].asString() == "invJW") {
+    phase_heuristic = DecisionHeuristic::PhaseHeuristicOption::INVJW;
+  } else {
+    assert(false);
+  }
+  decision_heuristic->setPhaseHeuristic(phase_heuristic);
+  string target_phases = args["--target-phases"].asString();
+  decision_heuristic->setTargetPhases(target_phases == "existential" || target_phases == "all",
+                                      target_phases == "universal" || target_phases == "all",
+                                      static_cast<uint32_t>(args["--rephase-interval"].asLong()));
+  return decision_heuristic;
+}
+
 int main(int argc, const char** argv)
 {
   std::map<std::string, docopt::value> args = docopt::docopt(USAGE, { argv + 1, argv + argc }, true, "Qute v.1.1");
@@ -151,6 +270,7 @@ int main(int argc, const char** argv)
 
   vector<string> decision_heuristics = {"VSIDS", "VMTF", "SGDB"};
   argument_constraints.push_back(make_unique<ListConstraint>(decision_heuristics, "--decision-heuristic"));
+  argument_constraints.push_back(make_unique<ListConstraint>(decision_heuristics, "--stable-decision-heuristic"));
   
   vector<string> restart_strategies = {"off", "luby", "inner-outer", "EMA"};
   argument_constraints.push_back(make_unique<ListConstraint>(restart_strategies, "--restarts"));
@@ -169,9 +289,17 @@ int main(int argc, const char** argv)
 
   vector<string> phase_heuristics = {"invJW", "qtype", "watcher", "random", "false", "true"};
   argument_constraints.push_back(make_unique<ListConstraint>(phase_heuristics, "--phase-heuristic"));
+  vector<string> target_phase_types = {"off", "existential", "universal", "all"};
+  argument_constraints.push_back(make_unique<ListConstraint>(target_phase_types, "--target-phases"));
+  argument_constraints.push_back(make_unique<RegexArgumentConstraint>(non_neg_int, "--rephase-interval", "unsigned int"));
 
   vector<string> VSIDS_tiebreak_strategies = {"arbitrary", "more-primary", "fewer-primary", "more-secondary", "fewer-secondary"};
   argument_constraints.push_back(make_unique<ListConstraint>(VSIDS_tiebreak_strategies, "--tiebreak"));
+  vector<string> VSIDS_queues = {"heap", "buckets"};
+  argument_constraints.push_back(make_unique<ListConstraint>(VSIDS_queues, "--vsids-queue"));
+
+  vector<string> depscheme_backends = {"queue", "bitparallel"};
+  argument_constraints.push_back(make_unique<ListConstraint>(depscheme_backends, "--depscheme-backend"));
 
   argument_constraints.push_back(make_unique<DoubleRangeConstraint>(0.5, 2, "--exponent"));
   argument_constraints.push_back(make_unique<DoubleRangeConstraint>(0, 1, "--scaling-factor"));
@@ -190,13 +318,32 @@ int main(int argc, const char** argv)
   argument_constraints.push_back(make_unique<DoubleRangeConstraint>(0, 1, "--alpha"));
   argument_constraints.push_back(make_unique<RegexArgumentConstraint>(non_neg_int, "--minimum-distance", "unsigned int"));
   argument_constraints.push_back(make_unique<DoubleRangeConstraint>(0, std::numeric_limits<double>::infinity(), "--threshold-factor", false, true));
+  argument_constraints.push_back(make_unique<DoubleRangeConstraint>(0, std::numeric_limits<double>::infinity(), "--term-threshold-factor", false, true));
+  vector<string> ema_signals = {"learned", "combined"};
+  argument_constraints.push_back(make_unique<ListConstraint>(ema_signals, "--ema-signal"));
+  argument_constraints.push_back(make_unique<DoubleRangeConstraint>(0, std::numeric_limits<double>::infinity(), "--blocking-factor", false, true));
+
+  argument_constraints.push_back(make_unique<RegexArgumentConstraint>(non_neg_int, "--stable-luby-multiplier", "unsigned int"));
+  argument_constraints.push_back(make_unique<RegexArgumentConstraint>(non_neg_int, "--mode-switch-interval", "unsigned int"));
+  argument_constraints.push_back(make_unique<DoubleRangeConstraint>(1, std::numeric_limits<double>::infinity(), "--mode-switch-multiplier", false, true));
 
   argument_constraints.push_back(make_unique<RegexArgumentConstraint>(non_neg_int, "--inner-restart-distance", "unsigned int"));
   argument_constraints.push_back(make_unique<RegexArgumentConstraint>(non_neg_int, "--outer-restart-distance", "unsigned int"));
   argument_constraints.push_back(make_unique<DoubleRangeConstraint>(1, std::numeric_limits<double>::infinity(), "--restart-multiplier", false, true));
 
-  argument_constraints.push_back(make_unique<IfThenConstraint>("--dependency-learning", "off", "--decision-heuristic", "VMTF",
-    "decision heuristic must be VMTF if dependency learning is deactivated"));
+  argument_constraints.push_back(make_unique<RegexArgumentConstraint>(non_neg_int, "--depscheme-threads", "unsigned int"));
+
+  vector<string> prefix_decision_heuristics = {"VMTF", "VSIDS"};
+  argument_constraints.push_back(make_unique<IfThenListConstraint>("--dependency-learning", "off", "--decision-heuristic", prefix_decision_heuristics,
+    "decision heuristic must be VMTF or VSIDS if dependency learning is deactivated"));
+  argument_constraints.push_back(make_unique<IfThenListConstraint>("--dependency-learning", "off", "--stable-decision-heuristic", prefix_decision_heuristics,
+    "stable decision heuristic must be VMTF or VSIDS if dependency learning is deactivated"));
+  argument_constraints.push_back(make_unique<IfThenConstraint>("--dependency-learning", "off", "--tiebreak", "arbitrary",
+    "tiebreaking is not supported if dependency learning is deactivated"));
+  argument_constraints.push_back(make_unique<IfThenConstraint>("--dependency-learning", "off", "--vsids-queue", "heap",
+    "the VSIDS bucket queue is not supported if dependency learning is deactivated"));
+  argument_constraints.push_back(make_unique<IfThenConstraint>("--vsids-queue", "buckets", "--tiebreak", "arbitrary",
+    "the VSIDS bucket queue does not support tiebreaking"));
 
   // TODO validate SMS args
 
@@ -253,83 +400,46 @@ int main(int argc, const char** argv)
   solver->variable_data_store = &variable_data_store;
 
 	string depscheme = args["--depscheme"].asString();
+  string depscheme_cache = args["--depscheme-cache"].isString() ? args["--depscheme-cache"].asString() : "";
   unique_ptr<DependencyManagerWatched> dependency_manager;
   if (depscheme == "upure") {
-    dependency_manager = make_unique<DependencyManagerUPure>(*solver, args["--dependency-learning"].asString(), args["--out-of-order-decisions"].asString());
+    dependency_manager = make_unique<DependencyManagerUPure>(*solver, args["--dependency-learning"].asString(), args["--out-of-order-decisions"].asString(),
+                                                             depscheme_cache);
 	} else if (depscheme == "off") {
     dependency_manager = make_unique<DependencyManagerWatched>(*solver, args["--dependency-learning"].asString(), args["--out-of-order-decisions"].asString());
   } else {
-    dependency_manager = make_unique<DependencyManagerRRS>(*solver, args["--dependency-learning"].asString(), args["--out-of-order-decisions"].asString());
+    dependency_manager = make_unique<DependencyManagerRRS>(*solver, args["--dependency-learning"].asString(), args["--out-of-order-decisions"].asString(),
+                                                           args["--depscheme-precompute"].asBool(),
+                                                           static_cast<unsigned>(args["--depscheme-threads"].asLong()),
+                                                           args["--depscheme-backend"].asString() == "bitparallel",
+                                                           depscheme_cache);
   }
   solver->dependency_manager = dependency_manager.get();
 
-  unique_ptr<DecisionHeuristic> decision_heuristic;
-
-if (args["--dependency-learning"].asString() == "off") {
-  decision_heuristic = make_unique<DecisionHeuristicVMTFprefix>(*solver, args["--no-phase-saving"].asBool());
-} else if (args["--decision-heuristic"].asString() == "VMTF") {
-  decision_heuristic = make_unique<DecisionHeuristicVMTFdeplearn>(*solver, args["--no-phase-saving"].asBool());
-} else if (args["--decision-heuristic"].asString() == "VSIDS") {
-  bool tiebreak_scores = false;
-  bool use_secondary_occurrences = false;
-  bool prefer_fewer_occurrences = false;
-  if (args["--tiebreak"].asString() == "arbitrary") {
-    tiebreak_scores = false;
-  } else if (args["--tiebreak"].asString() == "more-primary") {
-    tiebreak_scores = true;
-    use_secondary_occurrences = false;
-    prefer_fewer_occurrences = false;
-  } else if (args["--tiebreak"].asString() == "fewer-primary") {
-    tiebreak_scores = true;
-    use_secondary_occurrences = false;
-    prefer_fewer_occurrences = true;
-  } else if (args["--tiebreak"].asString() == "more-secondary") {
-    tiebreak_scores = true;
-    use_secondary_occurrences = true;
-    prefer_fewer_occurrences = false;
-  } else if (args["--tiebreak"].asString() == "fewer-secondary") {
-    tiebreak_scores = true;
-    use_secondary_occurrences = true;
-    prefer_fewer_occurrences = true;
-  } else {
-    assert(false);
-  }
-  decision_heuristic = make_unique<DecisionHeuristicVSIDSdeplearn>(*solver,
-                                                          args["--no-phase-saving"].asBool(),
-                                                          std::stod(args["--var-activity-decay"].asString()),
-                                                          std::stod(args["--var-activity-inc"].asString()),
-                                                          tiebreak_scores,
-                                                          use_secondary_occurrences,
-                                                          prefer_fewer_occurrences);
-  } else if (args["--decision-heuristic"].asString() == "SGDB") {
-    decision_heuristic = make_unique<DecisionHeuristicSGDB>(*solver,
-                                                    args["--no-phase-saving"].asBool(),
-                                                    std::stod(args["--initial-learning-rate"].asString()),
-                                                    std::stod(args["--learning-rate-decay"].asString()),
-                                                    std::stod(args["--learning-rate-minimum"].asString()),
-                                                    std::stod(args["--lambda-factor"].asString()));
+  unique_ptr<DecisionHeuristic> decision_heuristic = makeDecisionHeuristic(args, args["--decision-heuristic"].asString());
+  unique_ptr<DecisionHeuristicModeSwitch> mode_switch_heuristic;
+  if (args["--mode-switching"].asBool()) {
+    mode_switch_heuristic = make_unique<DecisionHeuristicModeSwitch>(*solver, std::move(decision_heuristic),
+                                                                     makeDecisionHeuristic(args, args["--stable-decision-heuristic"].asString()));
+    solver->decision_heuristic = mode_switch_heuristic.get();
   } else {
-    assert(false);
+    solver->decision_heuristic = decision_heuristic.get();
   }
-  solver->decision_heuristic = decision_heuristic.get();
 
-  DecisionHeuristic::PhaseHeuristicOption phase_heuristic = DecisionHeuristic::PhaseHeuristicOption::PHFALSE;
-  if (args["--phase-heuristic"].asString() == "qtype") {
-    phase_heuristic = DecisionHeuristic::PhaseHeuristicOption::QTYPE;
-  } else if (args["--phase-heuristic"].asString() == "watcher") {
-    phase_heuristic = DecisionHeuristic::PhaseHeuristicOption::WATCHER;
-  } else if (args["--phase-heuristic"].asString() == "random") {
-    phase_heuristic = DecisionHeuristic::PhaseHeuristicOption::RANDOM;
-  } else if (args["--phase-heuristic"].asString() == "false") {
-    phase_heuristic = DecisionHeuristic::PhaseHeuristicOption::PHFALSE;
-  } else if (args["--phase-heuristic"].asString() == "true") {
-    phase_heuristic = DecisionHeuristic::PhaseHeuristicOption::PHTRUE;
-  } else if (args["--phase-heuristic"].asString() == "invJW") {
-    phase_heuristic = DecisionHeuristic::PhaseHeuristicOption::INVJW;
-  } else {
-    assert(false);
+  HeuristicEventWriter heuristic_event_writer;
+  unique_ptr<DecisionHeuristicRecorder> decision_heuristic_recorder;
+  if (args["--record-heuristic-events"].isString()) {
+    string event_file = args["--record-heuristic-events"].asString();
+    uint32_t flags = (args["--model-generation"].asString() != "off" ? heuristic_event_log_model_generation : 0) |
+                     (args["--dependency-learning"].asString() == "off" ? heuristic_event_log_prefix_mode : 0);
+    if (!heuristic_event_writer.open(event_file, flags)) {
+      cerr << "qute: cannot write heuristic events '" << event_file << "'\n";
+      return 2;
+    }
+    decision_heuristic_recorder = make_unique<DecisionHeuristicRecorder>(*solver, *solver->decision_heuristic, heuristic_event_writer);
+    solver->decision_heuristic = decision_heuristic_recorder.get();
+    solver->heuristic_event_writer = &heuristic_event_writer;
   }
-  decision_heuristic->setPhaseHeuristic(phase_heuristic);
 
   unique_ptr<RestartScheduler> restart_scheduler;
 
@@ -347,15 +457,26 @@ if (args["--dependency-learning"].asString() == "off") {
     restart_scheduler = make_unique<RestartSchedulerEMA>(
       std::stod(args["--alpha"].asString()),
       static_cast<uint32_t>(args["--minimum-distance"].asLong()),
-      std::stod(args["--threshold-factor"].asString())
+      std::stod(args["--threshold-factor"].asString()),
+      std::stod(args["--term-threshold-factor"].asString()),
+      args["--ema-signal"].asString() == "combined",
+      std::stod(args["--blocking-factor"].asString())
     );
   } else {
     assert(false);
   }
+  if (mode_switch_heuristic) {
+    auto focused_restart_scheduler = std::move(restart_scheduler);
+    restart_scheduler = make_unique<RestartSchedulerModeSwitch>(*mode_switch_heuristic, std::move(focused_restart_scheduler),
+                                                                make_unique<RestartSchedulerLuby>(static_cast<uint32_t>(args["--stable-luby-multiplier"].asLong())),
+                                                                static_cast<uint32_t>(args["--mode-switch-interval"].asLong()),
+                                                                std::stod(args["--mode-switch-multiplier"].asString()));
+  }
 
   solver->restart_scheduler = restart_scheduler.get();
 
-  StandardLearningEngine learning_engine(*solver, depscheme != "off", args["--depscheme-term-learning-unsafe"].asBool());
+  StandardLearningEngine learning_engine(*solver, depscheme != "off", args["--depscheme-term-learning-unsafe"].asBool(),
+                                         args["--dependency-learning-batch"].asBool());
   solver->learning_engine = &learning_engine;
 
   unique_ptr<Propagator> propagator;
@@ -366,7 +487,13 @@ if (args["--dependency-learning"].asString() == "off") {
   }
   solver->propagator = propagator.get();
 
-  Parser parser(*solver, args["--model-generation"].asString() != "off");
+  bool use_model_generation = args["--model-generation"].asString() != "off";
+  unique_ptr<BinaryImageWriter> binary_image_writer;
+  if (args["--dump-binary"].isString()) {
+    binary_image_writer = make_unique<BinaryImageWriter>(*solver);
+  }
+  PCNFContainer& pcnf = binary_image_writer ? static_cast<PCNFContainer&>(*binary_image_writer) : *solver;
+  Parser parser(pcnf, use_model_generation);
 
   // PARSER
   if (args["<path>"]) {
@@ -375,6 +502,10 @@ if (args["--dependency-learning"].asString() == "off") {
     if (!ifs.is_open()) {
       cerr << "qute: cannot access '" << filename << "': no such file or directory \n";
       return 2;
+    } else if (isBinaryImage(filename)) {
+      ifs.close();
+      solver->filename = filename;
+      readBinaryImage(filename, pcnf, use_model_generation);
     } else {
       solver->filename = filename;
       parser.readAUTO(ifs);
@@ -385,6 +516,14 @@ if (args["--dependency-learning"].asString() == "off") {
     parser.readAUTO();
   }
 
+  if (binary_image_writer) {
+    string image_file = args["--dump-binary"].asString();
+    if (!binary_image_writer->write(image_file, use_model_generation)) {
+      cerr << "qute: cannot write binary image '" << image_file << "'\n";
+      return 2;
+    }
+  }
+
   //solver->variable_data_store->rename_auxiliary_variables();
   
   unique_ptr<ModelGenerator> model_generator;
@@ -417,6 +556,10 @@ if (args["--dependency-learning"].asString() == "off") {
     solver->printStatistics();
   }
 
+  if (decision_heuristic_recorder && !heuristic_event_writer.close(solver->variable_data_store->lastVariable())) {
+    cerr << "qute: cannot write heuristic events '" << args["--record-heuristic-events"].asString() << "'\n";
+  }
+
   //if (!solver->options.trace) {
     if (args["--machine-readable"].asBool()) {
       solver->machineReadableSummary();
@@ -44,6 +44,26 @@ protected:
 
 };
 
+class IfThenListConstraint: public ArgumentConstraint {
+public:
+  IfThenListConstraint(string first_parameter_name, string first_parameter_value, string second_parameter_name, vector<string> second_parameter_values, string error_message): first_parameter_name(first_parameter_name), first_parameter_value(first_parameter_value), second_parameter_name(second_parameter_name), second_parameter_values(second_parameter_values), error_message(error_message) {}
+
+  virtual bool check(map<string, docopt::value> args) {
+    return (!args[first_parameter_name] || args[first_parameter_name].asString() != first_parameter_value) ||
+      (args[second_parameter_name] && find(second_parameter_values.begin(), second_parameter_values.end(), args[second_parameter_name].asString()) != second_parameter_values.end());
+  }
+
+  virtual string message() {
+    return "ERROR: " + error_message;
+  }
+
+protected:
+  string first_parameter_name, first_parameter_value, second_parameter_name;
+  vector<string> second_parameter_values;
+  string error_message;
+
+};
+
 class ListConstraint: public ArgumentConstraint {
 public:
   ListConstraint(vector<string> legal_values, string parameter_name): parameter_name(parameter_name), legal_values(legal_values) {}
@@ -26,6 +26,74 @@ const char QCIR_QTYPE_MAP[QCIR_QTYPE_COUNT] = {QTYPE_EXISTS, QTYPE_FORALL, QTYPE
 
 const string QCIR_GATE[QCIR_GATE_COUNT] = {"and", "or", "xor", "ite"};
 
+void QCIRNameMap::clear() {
+    slots.clear();
+    pool.clear();
+    nr_entries = 0;
+}
+
+const QCIRNameMap::Entry* QCIRNameMap::find(QCIRName name) const {
+    if (slots.empty()) {
+        return nullptr;
+    }
+    const Entry& entry = slots[findSlot(name)];
+    return entry.variable != 0 ? &entry : nullptr;
+}
+
+bool QCIRNameMap::insert(QCIRName name, int32_t variable, bool is_gate) {
+    // Keep the load factor at most 1/2.
+    if (2 * (nr_entries + 1) > slots.size()) {
+        grow();
+    }
+    Entry& entry = slots[findSlot(name)];
+    if (entry.variable != 0) {
+        return false;
+    }
+    entry.offset = pool.size();
+    entry.size = name.size;
+    entry.variable = variable;
+    entry.is_gate = is_gate;
+    pool.append(name.data, name.size);
+    nr_entries++;
+    return true;
+}
+
+// FNV-1a
+uint32_t QCIRNameMap::hash(QCIRName name) {
+    uint32_t h = 2166136261u;
+    for (size_t i = 0; i < name.size; i++) {
+        h ^= static_cast<unsigned char>(name[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Returns the slot holding name, or the empty slot where it would be inserted.
+size_t QCIRNameMap::findSlot(QCIRName name) const {
+    size_t mask = slots.size() - 1;
+    size_t i = hash(name) & mask;
+    while (slots[i].variable != 0 &&
+           (slots[i].size != name.size || pool.compare(slots[i].offset, slots[i].size, name.data, name.size) != 0)) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+void QCIRNameMap::grow() {
+    std::vector<Entry> old_slots(slots.empty() ? 1024 : 2 * slots.size(), Entry{0, 0, 0, false});
+    old_slots.swap(slots);
+    size_t mask = slots.size() - 1;
+    for (Entry& entry: old_slots) {
+        if (entry.variable != 0) {
+            size_t i = hash(QCIRName(pool.data() + entry.offset, entry.size)) & mask;
+            while (slots[i].variable != 0) {
+                i = (i + 1) & mask;
+            }
+            slots[i] = entry;
+        }
+    }
+}
+
 istream& Parser::getline(istream& ifs, std::string& str) {
     ++current_line;
     return std::getline(ifs, str);
@@ -68,7 +136,8 @@ void Parser::readQDIMACS(istream& ifs) {
     ifs >> max_var;
     ifs >> num_clauses;
 
-    pcnf.notifyMaxVarDeclaration(max_var);
+    // Without model generation, every clause also introduces an auxiliary Tseitin variable.
+    pcnf.notifyMaxVarDeclaration(use_model_generation ? max_var : max_var + num_clauses);
     pcnf.notifyNumClausesDeclaration(num_clauses);
 
     // this calls the internal wrapper around std::getline, which also updates current_line
@@ -109,7 +178,7 @@ void Parser::readQDIMACS(istream& ifs) {
               duplicate_variable_error(current_var);
             }
             var_conversion_map[current_var] = vars_seen;
-            pcnf.addVariable(std::to_string(current_var), current_qtype, false);
+            pcnf.addVariable(current_var, current_qtype, false);
             ifs >> current_var;
         }
         getline(ifs, line);
@@ -154,7 +223,7 @@ void Parser::readQDIMACS(istream& ifs) {
                 if (!use_model_generation) {
                     // add all of the Tseitin terms
                     vars_seen++;
-                    pcnf.addVariable(std::to_string(max_var + clauses_seen), QTYPE_FORALL, true);
+                    pcnf.addVariable(static_cast<Variable>(max_var + clauses_seen), QTYPE_FORALL, true);
                     top_level_term.push_back(mkLiteral(vars_seen, true));
                     for (auto lit: temp_clause) {
                         pcnf.addDependency(vars_seen, var(lit));
@@ -174,61 +243,56 @@ void Parser::readQDIMACS(istream& ifs) {
 void Parser::readQCIR(istream& ifs) {
     string line;
 
-    qcir_var_conversion_map.clear();
+    qcir_name_map.clear();
     nr_vars = 0;
     current_line = 0;
-    string qcir_output_clause_var = "", qcir_output_term_var = "";
+    string qcir_output_var = "";
     bool qcir_output_polarity = true;
 
     bool is_prefix_line;
-    vector<string> inputs;
+    vector<QCIRName> inputs;
     while (getline(ifs, line)) {
         size_t idx = 0;
         skip_space(line, idx);
         if (idx == line.size() || line[idx] == '#') {
             continue;
         }
-        string identifier = extract_next(line, idx, "(=");
+        QCIRName identifier = extract_next(line, idx, "(=");
         is_prefix_line = (line[idx] == '(');
         if (is_prefix_line) {
-            std::transform(identifier.begin(), identifier.end(), identifier.begin(), ::tolower);
             bool is_quantifier_block = false;
             uint32_t qtype;
             for (qtype = 0; qtype < QCIR_QTYPE_COUNT; qtype++) {
-                if (identifier == QCIR_QTYPE[qtype]) {
+                if (identifier.equalsKeyword(QCIR_QTYPE[qtype])) {
                     is_quantifier_block = true;
                     break;
                 }
             }
             if (is_quantifier_block) {
                 while (line[idx] != ')' && ++idx < line.size()) {
-                    pushQCIRVar(extract_next(line, idx, ",)"), QCIR_QTYPE_MAP[qtype], false);
+                    pushQCIRVar(extract_next(line, idx, ",)"), QCIR_QTYPE_MAP[qtype]);
                 }
                 if (idx >= line.size()) {
                     unexpected_eol_error();
                 }
-            } else if (identifier == "output") {
-                if (qcir_output_clause_var != "") {
+            } else if (identifier.equalsKeyword("output")) {
+                if (qcir_output_var != "") {
                     duplicate_qcir_output_gate_error();
                 }
-                string name = extract_lit(line, ++idx);
-                if (name[0] == '-') {
+                QCIRName name = extract_lit(line, ++idx);
+                if (!name.empty() && name[0] == '-') {
                   qcir_output_polarity = false;
                   name = name.substr(1);
                 }
-                //qcir_output_clause_var = name + ".e";
-                //qcir_output_term_var = name + ".a";
-                qcir_output_clause_var = name;
-                qcir_output_term_var = name;
+                qcir_output_var = name.str();
             } else {
-                unknown_identifier_error(identifier);
+                unknown_identifier_error(identifier.str());
             }
         } else {
-            string gate_type = extract_next(line, ++idx, "(");
-            std::transform(gate_type.begin(), gate_type.end(), gate_type.begin(), ::tolower);
+            QCIRName gate_type = extract_next(line, ++idx, "(");
             bool is_valid_gate = false;
             for (uint32_t i = 0; i < QCIR_GATE_COUNT; i++) {
-                if (gate_type == QCIR_GATE[i]) {
+                if (gate_type.equalsKeyword(QCIR_GATE[i])) {
                     inputs.clear();
                     while (line[idx] != ')' && ++idx < line.size()) {
                         inputs.push_back(extract_lit(line, idx));
@@ -249,74 +313,55 @@ void Parser::readQCIR(istream& ifs) {
                 }
             }
             if (!is_valid_gate) {
-                invalid_gate_type_error(gate_type);
+                string gate_type_name = gate_type.str();
+                std::transform(gate_type_name.begin(), gate_type_name.end(), gate_type_name.begin(), ::tolower);
+                invalid_gate_type_error(gate_type_name);
             }
         }
     }
-    if (qcir_output_clause_var == "") {
+    if (qcir_output_var == "") {
         output_gate_missing_error();
     }
-    vector<Literal> output_clause{mkLiteral(qcir_cls_var_conversion_map.at(qcir_output_clause_var), qcir_output_polarity)};
-    vector<Literal> output_term{mkLiteral(qcir_trm_var_conversion_map.at(qcir_output_term_var), qcir_output_polarity)};
+    const QCIRNameMap::Entry* output = qcir_name_map.find(QCIRName(qcir_output_var.data(), qcir_output_var.size()));
+    if (output == nullptr) {
+        unknown_identifier_error(qcir_output_var);
+    }
+    vector<Literal> output_clause{mkLiteral(output->variable, qcir_output_polarity)};
+    vector<Literal> output_term{mkLiteral(output->variable + output->is_gate, qcir_output_polarity)};
     pcnf.addConstraint(output_clause, ConstraintType::clauses);
     pcnf.addConstraint(output_term, ConstraintType::terms);
 }
 
-void Parser::addQCIRGate(string gate_name, uint32_t gate_type, vector<string>& inputs) {
-    //string existential_var_name = gate_name + ".e";
-    //string universal_var_name = gate_name + ".a";
-    // experimental: the same original name for both the existential and universal gate variable
-    string existential_var_name = gate_name;
-    string universal_var_name = gate_name;
+void Parser::addQCIRGate(QCIRName gate_name, uint32_t gate_type, vector<QCIRName>& inputs) {
     // Detect duplicate gate definitions
-    if (qcir_var_conversion_map.find(gate_name) != qcir_var_conversion_map.end()) {
-        duplicate_qcir_gate_error(gate_name);
+    if (qcir_name_map.find(gate_name) != nullptr) {
+        duplicate_qcir_gate_error(gate_name.str());
     }
-    /*if (qcir_var_conversion_map.find(existential_var_name) != qcir_var_conversion_map.end()) {
-        duplicate_qcir_gate_error(gate_name);
-    }*/
     vector<int32_t> clause_inputs, term_inputs;
     clause_inputs.reserve(inputs.size());
     term_inputs.reserve(inputs.size());
-    uint32_t num_empty_inputs = 0;
-    for (string& input : inputs) {
-        string clause_key, term_key;
+    for (QCIRName& input : inputs) {
         int32_t neg_multiplier = 1;
+        QCIRName key = input;
         if (input[0] == '-') {
             neg_multiplier = -1;
-            clause_key = input.substr(1);
-            term_key = input.substr(1);
-        } else {
-            clause_key = input;
-            term_key = input;
+            key = input.substr(1);
         }
-        if (clause_key == "") {
-            num_empty_inputs++;
-        }
-        int32_t cls_input_literal_id = 0;
-        int32_t trm_input_literal_id = 0;
-
-        if (qcir_var_conversion_map.find(clause_key) != qcir_var_conversion_map.end()) {
-          cls_input_literal_id = neg_multiplier * qcir_var_conversion_map[clause_key];
-          trm_input_literal_id = cls_input_literal_id;
-        } else {
-          if (qcir_cls_var_conversion_map.find(clause_key) != qcir_cls_var_conversion_map.end()) {
-              cls_input_literal_id = neg_multiplier * qcir_cls_var_conversion_map.at(clause_key);
-          }
-          if (qcir_trm_var_conversion_map.find(clause_key) != qcir_trm_var_conversion_map.end()) {
-              trm_input_literal_id = neg_multiplier * qcir_trm_var_conversion_map.at(clause_key);
-          }
-        }
-
-        if (cls_input_literal_id != 0 && trm_input_literal_id != 0) {
-          clause_inputs.push_back(cls_input_literal_id);
-          term_inputs.push_back(trm_input_literal_id);
-        } else {
-          undeclared_gate_input_literal_error(input);
+        const QCIRNameMap::Entry* entry = qcir_name_map.find(key);
+        if (entry == nullptr) {
+            undeclared_gate_input_literal_error(input.str());
         }
+        // The term variable of a gate directly follows its clause variable.
+        clause_inputs.push_back(neg_multiplier * entry->variable);
+        term_inputs.push_back(neg_multiplier * (entry->variable + entry->is_gate));
     }
-    pushQCIRVar(existential_var_name, QTYPE_EXISTS, true);
-    pushQCIRVar(universal_var_name, QTYPE_FORALL, true);
+    /* experimental: the same original name for both the existential and universal gate variable
+     * (before, these used to be gate_name + ".e" and gate_name + ".a") */
+    string var_name = gate_name.str();
+    qcir_name_map.insert(gate_name, nr_vars + 1, true);
+    nr_vars += 2;
+    pcnf.addVariable(var_name, QTYPE_EXISTS, true);
+    pcnf.addVariable(var_name, QTYPE_FORALL, true);
     int32_t gate_clause_var = nr_vars - 1;
     int32_t gate_term_var = nr_vars;
     for (int32_t lit : clause_inputs) {
@@ -444,27 +489,12 @@ void Parser::addQCIRGate(string gate_name, uint32_t gate_type, vector<string>& i
     }
 }
 
-void Parser::pushQCIRVar(const string& var_name, char qtype, bool auxiliary) {
-    /* if the variable is not auxiliary, push it to the shared map,
-     * otherwise push it to the map based on qtype */
-    if (!auxiliary) {
-      assert(qcir_var_conversion_map.find(var_name) == qcir_var_conversion_map.end());
-      nr_vars++;
-      qcir_var_conversion_map.insert({var_name, nr_vars});
-      pcnf.addVariable(var_name, qtype, auxiliary);
-    } else {
-      if (qtype == QTYPE_FORALL) {
-        assert(qcir_trm_var_conversion_map.find(var_name) == qcir_trm_var_conversion_map.end());
-        nr_vars++;
-        qcir_trm_var_conversion_map.insert({var_name, nr_vars});
-        pcnf.addVariable(var_name, qtype, auxiliary);
-      } else {
-        assert(qcir_cls_var_conversion_map.find(var_name) == qcir_cls_var_conversion_map.end());
-        nr_vars++;
-        qcir_cls_var_conversion_map.insert({var_name, nr_vars});
-        pcnf.addVariable(var_name, qtype, auxiliary);
-      }
+void Parser::pushQCIRVar(QCIRName var_name, char qtype) {
+    if (!qcir_name_map.insert(var_name, nr_vars + 1, false)) {
+        duplicate_qcir_variable_error(var_name.str());
     }
+    nr_vars++;
+    pcnf.addVariable(var_name.str(), qtype, false);
 }
 
 char * Parser::uintToCharArray(uint32_t x) {
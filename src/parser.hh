@@ -1,11 +1,12 @@
 #ifndef parser_hh
 #define parser_hh
 
+#include <cctype>
 #include <istream>
 #include <fstream>
 #include <iostream>
 #include <string>
-#include <map>
+#include <vector>
 #include "pcnf_container.hh"
 #include "solver_types.hh"
 
@@ -21,20 +22,75 @@ inline void skip_space(const std::string& str, size_t& idx) {
     }
 }
 
+/* A reference to a name inside the line currently being parsed. Tokens are
+ * only ever looked at through such references, so reading a gate does not
+ * allocate. */
+struct QCIRName {
+    const char* data;
+    size_t size;
+
+    QCIRName(): data(nullptr), size(0) {}
+    QCIRName(const char* data, size_t size): data(data), size(size) {}
+
+    bool empty() const { return size == 0; }
+    char operator[](size_t i) const { return data[i]; }
+    QCIRName substr(size_t pos) const { return QCIRName(data + pos, size - pos); }
+    std::string str() const { return std::string(data, size); }
+
+    // Case-insensitive comparison with a lowercase keyword.
+    bool equalsKeyword(const std::string& keyword) const {
+        if (size != keyword.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < size; i++) {
+            if (std::tolower(data[i]) != keyword[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/* Maps QCIR names to variables using open addressing with linear probing.
+ * The names themselves are interned into a single character pool, lookups
+ * take a QCIRName and never allocate. A gate g is Tseitin-encoded by two
+ * consecutive variables, the existential one for clauses and the universal one
+ * for terms, and only the first of them is stored. */
+class QCIRNameMap {
+public:
+    struct Entry {
+        uint32_t offset;
+        uint32_t size;
+        int32_t variable; // 0 marks an empty slot
+        bool is_gate;
+    };
+
+    QCIRNameMap(): nr_entries(0) {}
+    void clear();
+    const Entry* find(QCIRName name) const;
+    bool insert(QCIRName name, int32_t variable, bool is_gate);
+
+protected:
+    static uint32_t hash(QCIRName name);
+    size_t findSlot(QCIRName name) const;
+    void grow();
+
+    std::vector<Entry> slots;
+    std::string pool;
+    size_t nr_entries;
+};
+
 class Parser {
     PCNFContainer& pcnf;
     bool use_model_generation;
-    std::map<std::string, int32_t> qcir_var_conversion_map;
-    std::map<std::string, int32_t> qcir_cls_var_conversion_map;
-    std::map<std::string, int32_t> qcir_trm_var_conversion_map;
+    QCIRNameMap qcir_name_map;
     int32_t nr_vars;
     uint32_t current_line = 0;
 
     // helper methods
     char* uintToCharArray(uint32_t x);
-    void addQCIRVars(const std::string& vars, char qtype);
-    void pushQCIRVar(const std::string& var_name, char qtype, bool auxiliary);
-    void addQCIRGate(std::string gate_name, uint32_t gate_type, std::vector<std::string>& inputs);
+    void pushQCIRVar(QCIRName var_name, char qtype);
+    void addQCIRGate(QCIRName gate_name, uint32_t gate_type, std::vector<QCIRName>& inputs);
 
 public:
     Parser(PCNFContainer& pcnf, bool use_model_generation): pcnf(pcnf), use_model_generation(use_model_generation) {}
@@ -88,6 +144,11 @@ public:
       exit(1);
     }
 
+    inline void duplicate_qcir_variable_error(const string& var_name) {
+        std::cerr << error_header << "Duplicate variable '" << var_name << "' at line " << current_line << std::endl;
+        exit(1);
+    }
+
     inline void duplicate_qcir_output_gate_error() {
         std::cerr << error_header << "Duplicate output gate at line " << current_line << std::endl;
         exit(1);
@@ -134,7 +195,7 @@ public:
         }
     } 
 
-    inline std::string extract_next(const std::string& str, size_t& idx, const std::string& delimiters) {
+    inline QCIRName extract_next(const std::string& str, size_t& idx, const std::string& delimiters) {
         skip_space(str, idx);
         size_t begin = idx;
         size_t length = 0;
@@ -157,10 +218,10 @@ public:
             empty_identifier_error();
         }
         //std::cerr << "extracted token: " << token << std::endl;
-        return str.substr(begin, length);
+        return QCIRName(str.data() + begin, length);
     }
 
-    inline std::string extract_lit(const std::string& str, size_t& idx) {
+    inline QCIRName extract_lit(const std::string& str, size_t& idx) {
         skip_space(str, idx);
         size_t begin = idx;
         size_t length = 0;
@@ -194,7 +255,7 @@ public:
             unexpected_char_error(str[idx], idx+1);
         }
         //std::cerr << "extracted literal: " << token << std::endl;
-        return str.substr(begin, length);
+        return QCIRName(str.data() + begin, length);
     }
 };
 
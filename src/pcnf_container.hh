@@ -14,6 +14,7 @@ class PCNFContainer {
 
 public:
   virtual void addVariable(string original_name, char variable_type, bool auxiliary) = 0;
+  virtual void addVariable(Variable original_id, char variable_type, bool auxiliary) = 0;
   virtual CRef addConstraint(vector<Literal>& literals, ConstraintType constraint_type) = 0;
   virtual void addDependency(Variable of, Variable on) = 0;
   virtual void notifyMaxVarDeclaration(Variable max_var) = 0;
@@ -0,0 +1,97 @@
+#ifndef phase_profiler_hh
+#define phase_profiler_hh
+
+#include <chrono>
+#include <cstdint>
+
+/* Attributes solving time to the subsystems of QCDCL_solver::solve. Only
+ * compiled in when PHASE_PROFILING is defined (cmake -DPROFILING=on),
+ * otherwise PROFILE_PHASE expands to nothing. */
+#ifdef PHASE_PROFILING
+#define PROFILE_PHASE(SOLVER, PHASE) Qute::PhaseScope phase_scope((SOLVER).phase_profiler, Qute::Phase::PHASE)
+#else
+#define PROFILE_PHASE(SOLVER, PHASE)
+#endif
+
+namespace Qute {
+
+enum class Phase: uint8_t {other, propagation, model_generation, decisions, conflict_analysis, dependency_learning, backtracking, constraint_cleaning, relocation};
+
+/* Time is attributed to the innermost phase only: entering a phase
+ * charges the time since the last event to the phase it interrupts. */
+class PhaseProfiler {
+
+public:
+  static const uint8_t nr_phases = 9;
+
+  PhaseProfiler();
+  void start();
+  Phase enter(Phase phase);
+  void leave(Phase resumed);
+  double seconds(Phase phase) const;
+
+protected:
+  typedef std::chrono::steady_clock clock;
+  void charge(clock::time_point now);
+
+  Phase current;
+  clock::time_point last_event;
+  clock::duration elapsed[nr_phases];
+
+};
+
+class PhaseScope {
+
+public:
+  PhaseScope(PhaseProfiler& profiler, Phase phase);
+  ~PhaseScope();
+
+protected:
+  PhaseProfiler& profiler;
+  Phase resumed;
+
+};
+
+// Implementation of inline methods.
+
+inline PhaseProfiler::PhaseProfiler(): current(Phase::other), last_event(clock::now()) {
+  for (auto& duration: elapsed) {
+    duration = clock::duration::zero();
+  }
+}
+
+inline void PhaseProfiler::start() {
+  current = Phase::other;
+  last_event = clock::now();
+}
+
+inline Phase PhaseProfiler::enter(Phase phase) {
+  charge(clock::now());
+  Phase interrupted = current;
+  current = phase;
+  return interrupted;
+}
+
+inline void PhaseProfiler::leave(Phase resumed) {
+  charge(clock::now());
+  current = resumed;
+}
+
+inline double PhaseProfiler::seconds(Phase phase) const {
+  return std::chrono::duration<double>(elapsed[static_cast<uint8_t>(phase)]).count();
+}
+
+inline void PhaseProfiler::charge(clock::time_point now) {
+  elapsed[static_cast<uint8_t>(current)] += now - last_event;
+  last_event = now;
+}
+
+inline PhaseScope::PhaseScope(PhaseProfiler& profiler, Phase phase): profiler(profiler), resumed(profiler.enter(phase)) {}
+
+inline PhaseScope::~PhaseScope() {
+  profiler.leave(resumed);
+}
+
+}
+
+#endif
@@ -9,6 +9,7 @@ class Propagator {
 
 public:
   virtual void addVariable() = 0;
+  virtual void notifyMaxVarDeclaration(Variable max_var) {}
   virtual CRef propagate(ConstraintType& constraint_type) = 0;
   virtual void addConstraint(CRef constraint_reference, ConstraintType constraint_type) = 0;
   //virtual void removeConstraint(CRef constraint_reference, ConstraintType constraint_type) = 0;
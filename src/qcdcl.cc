@@ -20,6 +20,18 @@
 
 namespace Qute {
 
+#ifdef PHASE_PROFILING
+// Indexed by Phase.
+static const char* const phase_columns[PhaseProfiler::nr_phases] = {
+  "time_other", "time_propagation", "time_model_generation", "time_decisions", "time_conflict_analysis",
+  "time_dependency_learning", "time_backtracking", "time_constraint_cleaning", "time_relocation"
+};
+static const char* const phase_descriptions[PhaseProfiler::nr_phases] = {
+  "other search steps", "propagation", "model generation", "decisions", "conflict analysis",
+  "dependency learning", "backtracking", "constraint cleaning", "constraint relocation"
+};
+#endif
+
 void QCDCL_solver::machineReadableHeader() {
 	std::cout
 		<< "id"
@@ -38,6 +50,8 @@ void QCDCL_solver::machineReadableHeader() {
 		<< "," << "fraction_decisions_assignments"
 		<< "," << "backtracks"
 		<< "," << "backtracks_deplearn"
+		<< "," << "restarts"
+		<< "," << "blocked_restarts"
 		<< "," << "depscheme_resolved_conflicts"
 		<< "," << "proven_independencies"
 		<< "," << "depscheme-reduced_literals"
@@ -46,9 +60,13 @@ void QCDCL_solver::machineReadableHeader() {
 		<< "," << "fraction_independent_trivial_deps"
 		<< "," << "fraction_learned_trivial_deps"
 		<< "," << "initial_terms"
-		<< "," << "initial_terms_avg_size"
-		<< "," << "total_time"
-		<< std::endl;
+		<< "," << "initial_terms_avg_size";
+#ifdef PHASE_PROFILING
+  for (auto column: phase_columns) {
+    std::cout << "," << column;
+  }
+#endif
+  std::cout << std::endl;
 }
 
 void QCDCL_solver::machineReadableSummary() {
@@ -98,6 +116,8 @@ void QCDCL_solver::machineReadableSummary() {
 	<< "," << frac_dec_ass
 	<< "," << solver_statistics.backtracks_total
 	<< "," << solver_statistics.backtracks_dep
+	<< "," << solver_statistics.nr_restarts
+	<< "," << restart_scheduler->nrBlockedRestarts()
 	<< "," << solver_statistics.dep_conflicts_resolved
 	<< "," << solver_statistics.nr_independencies
 	<< "," << solver_statistics.nr_depscheme_reduced_lits
@@ -106,8 +126,13 @@ void QCDCL_solver::machineReadableSummary() {
 	<< "," << frac_indep_trv
 	<< "," << frac_lrn_trv
 	<< "," << solver_statistics.initial_terms_generated
-	<< "," << solver_statistics.average_initial_term_size
-	<< std::endl;
+	<< "," << solver_statistics.average_initial_term_size;
+#ifdef PHASE_PROFILING
+  for (uint8_t phase = 0; phase < PhaseProfiler::nr_phases; phase++) {
+    std::cout << "," << phase_profiler.seconds(Phase(phase));
+  }
+#endif
+  std::cout << std::endl;
 
 }
 
@@ -123,16 +148,30 @@ void QCDCL_solver::printStatistics() {
   }
   std::cout << "Number of backtracks: " << solver_statistics.backtracks_total << "\n";
   std::cout << "Number of backtracks caused by dependency learning: " << solver_statistics.backtracks_dep << "\n";
+  std::cout << "Number of restarts: " << solver_statistics.nr_restarts << "\n";
+  std::cout << "Number of blocked restarts: " << restart_scheduler->nrBlockedRestarts() << "\n";
+  std::cout << "Number of dependency conflicts learned from: " << solver_statistics.nr_dependency_conflicts << "\n";
+  std::cout << "Number of prefetched dependencies: " << solver_statistics.nr_prefetched_dependencies << "\n";
+  if (solver_statistics.nr_dependencies) {
+    std::cout << "Dependency learning backtracks per learned dependency: " << double(solver_statistics.backtracks_dep) / double(solver_statistics.nr_dependencies) << "\n";
+  }
   std::cout << "Number of dependency conflicts resolved by depscheme: " << solver_statistics.dep_conflicts_resolved << "\n";
   std::cout << "Number of proven independencies: " << solver_statistics.nr_independencies << std::endl;
+  std::cout << "Number of independence sets invalidated by added clauses: " << solver_statistics.nr_invalidated_independence_sets << std::endl;
   std::cout << "Number of depscheme-reduced literals: " << solver_statistics.nr_depscheme_reduced_lits << std::endl;
   std::cout << "Amount of time spent computing depscheme (s): " << double(solver_statistics.time_spent_computing_depscheme) / CLOCKS_PER_SEC << std::endl;
+  std::cout << "Wall time spent precomputing depscheme (s): " << solver_statistics.wall_time_precomputing_depscheme << std::endl;
   std::cout << "Amount of time spent on generalized forall reduction (s): " << double(solver_statistics.time_spent_reducing_by_depscheme) / CLOCKS_PER_SEC << std::endl;
   if (computeNrTrivial()) {
     std::cout << "Learned dependencies as a fraction of trivial: " << double(solver_statistics.nr_dependencies) / double(computeNrTrivial()) << std::endl;
   }
   std::cout << "Number of initial terms generated: " << solver_statistics.initial_terms_generated << std::endl;
   std::cout << "Average initial term size: " << solver_statistics.average_initial_term_size << std::endl;
+#ifdef PHASE_PROFILING
+  for (uint8_t phase = 0; phase < PhaseProfiler::nr_phases; phase++) {
+    std::cout << "Time spent on " << phase_descriptions[phase] << " (s): " << phase_profiler.seconds(Phase(phase)) << std::endl;
+  }
+#endif
 
   double total_time = (double)(clock() - t_birth) / CLOCKS_PER_SEC;
   std::cout << "Total time (seconds): " << total_time << std::endl;
@@ -152,14 +191,15 @@ using std::string;
 
 string QCDCL_solver::externalize(Literal lit) const {
   string out_string = (sign(lit) ? "" : "-");
-  out_string += variable_data_store->originalName(var(lit));
+  variable_data_store->appendOriginalName(out_string, var(lit));
   return out_string;
 }
 
 string QCDCL_solver::externalize(const vector<Literal> &lits) const {
   string out_string;
   for (Literal lit : lits) {
-    out_string += externalize(lit);
+    out_string += (sign(lit) ? "" : "-");
+    variable_data_store->appendOriginalName(out_string, var(lit));
     out_string += " ";
   }
   out_string += "0";
@@ -169,7 +209,8 @@ string QCDCL_solver::externalize(const vector<Literal> &lits) const {
 string QCDCL_solver::externalize(const Constraint &lits) const {
   string out_string;
   for (Literal lit : lits) {
-    out_string += externalize(lit);
+    out_string += (sign(lit) ? "" : "-");
+    variable_data_store->appendOriginalName(out_string, var(lit));
     out_string += " ";
   }
   out_string += "0";
@@ -190,9 +231,19 @@ QCDCL_solver::~QCDCL_solver() {}
  * the var_type equals the constraint_type for which that var_type is primary
  */
 void QCDCL_solver::addVariable(string original_name, char variable_type, bool auxiliary) {
+  variable_data_store->addVariable(original_name, variable_type == 'a');
+  initializeVariable(variable_type, auxiliary);
+}
+
+// Same as above, for variables whose original name is the integer original_id.
+void QCDCL_solver::addVariable(Variable original_id, char variable_type, bool auxiliary) {
+  variable_data_store->addVariable(original_id, variable_type == 'a');
+  initializeVariable(variable_type, auxiliary);
+}
+
+void QCDCL_solver::initializeVariable(char variable_type, bool auxiliary) {
   bool var_type = (variable_type == 'a'); // universal variables have var_type true
   // TODO clean this up
-  variable_data_store->addVariable(original_name, var_type);
   if (variable_type == 'f') {
     variable_data_store->to_enumerate.push_back(variable_data_store->lastVariable());
   }
@@ -211,6 +262,7 @@ CRef QCDCL_solver::addConstraint(vector<Literal>& literals, ConstraintType const
   literals.erase(unique(literals.begin(), literals.end()), literals.end());
   CRef constraint_reference = constraint_database->addConstraint(literals, constraint_type, false, false);
   propagator->addConstraint(constraint_reference, constraint_type);
+  decision_heuristic->notifyInputConstraintAdded(constraint_database->getConstraint(constraint_reference, constraint_type), constraint_type);
   return constraint_reference;
 }
 
@@ -239,6 +291,9 @@ void QCDCL_solver::addConstraintDuringSearch(std::vector<Literal>& literals, Con
   CRef cref;
 
   cref = addConstraint(literals, constraint_type);
+  if (constraint_type == ConstraintType::clauses) {
+    dependency_manager->notifyInputClauseAdded(literals);
+  }
   if (options.trace) {
 	  tracer->traceConstraint(constraint_database->getConstraint(cref, constraint_type), constraint_type, std::vector<uint32_t>());
   }
@@ -251,6 +306,7 @@ void QCDCL_solver::addConstraintDuringSearch(std::vector<Literal>& literals, Con
   for (size_t i = 0; i < output_term.size(); i++) {
     orig_output[i] = output_term[i];
   }
+  decision_heuristic->notifyInputConstraintRemoved(output_term, opp);
   
   /* TODO not all tainted constraints must necessarily be deleted
    * since we can always add fresh_pos (see below) to every tainted derivation
@@ -271,6 +327,9 @@ void QCDCL_solver::addConstraintDuringSearch(std::vector<Literal>& literals, Con
     addDependency(fresh, var(l));
     vector<Literal> binary = {fresh_neg, l};
     cref = addConstraint(binary, opp);
+    if (opp == ConstraintType::clauses) {
+      dependency_manager->notifyInputClauseAdded(binary);
+    }
 	  if (options.trace) {
 		  tracer->traceConstraint(constraint_database->getConstraint(cref, opp), opp, std::vector<uint32_t>());
 	  }
@@ -280,6 +339,9 @@ void QCDCL_solver::addConstraintDuringSearch(std::vector<Literal>& literals, Con
     top_level[i] = ~literals[i-1];
   }
   cref = addConstraint(top_level, opp);
+  if (opp == ConstraintType::clauses) {
+    dependency_manager->notifyInputClauseAdded(top_level);
+  }
   if (options.trace) {
 	  tracer->traceConstraint(constraint_database->getConstraint(cref, opp), opp, std::vector<uint32_t>());
   }
@@ -302,9 +364,17 @@ void QCDCL_solver::addDependency(Variable of, Variable on) {
   }
 }
 
-void QCDCL_solver::notifyMaxVarDeclaration(Variable max_var) {}
+void QCDCL_solver::notifyMaxVarDeclaration(Variable max_var) {
+  variable_data_store->notifyMaxVarDeclaration(max_var);
+  constraint_database->notifyMaxVarDeclaration(max_var);
+  propagator->notifyMaxVarDeclaration(max_var);
+  decision_heuristic->notifyMaxVarDeclaration(max_var);
+  dependency_manager->notifyMaxVarDeclaration(max_var);
+}
 
-void QCDCL_solver::notifyNumClausesDeclaration(uint32_t max_var) {}
+void QCDCL_solver::notifyNumClausesDeclaration(uint32_t num_clauses) {
+  constraint_database->notifyNumClausesDeclaration(num_clauses);
+}
 
 Literal QCDCL_solver::getUnitLiteralAfterBacktrack(vector<Literal> &clause) {
   uint32_t highest_dl = 0;
@@ -336,6 +406,10 @@ Literal QCDCL_solver::getUnitLiteralAfterBacktrack(vector<Literal> &clause) {
 
 lbool QCDCL_solver::solve() {
   t_solve_begin = clock();
+#ifdef PHASE_PROFILING
+  phase_profiler.start();
+#endif
+  PROFILE_PHASE(*this, other);
   constraint_database->notifyStart();
   dependency_manager->notifyStart();
   decision_heuristic->notifyStart();
@@ -364,7 +438,11 @@ lbool QCDCL_solver::solve() {
       return l_Undef;
     }
     ConstraintType constraint_type;
-    CRef conflict_constraint_reference = propagator->propagate(constraint_type);
+    CRef conflict_constraint_reference;
+    {
+      PROFILE_PHASE(*this, propagation);
+      conflict_constraint_reference = propagator->propagate(constraint_type);
+    }
     if (conflict_constraint_reference == CRef_Undef) {
       if (ext_prop && !ext_prop->checkAssignment()) {
         /* there is a problem with adding clauses: learned terms become invalidated
@@ -375,11 +453,13 @@ lbool QCDCL_solver::solve() {
          */
         continue;
       }
+      PROFILE_PHASE(*this, decisions);
       Literal l = decision_heuristic->getDecisionLiteral();
       enqueue(l, CRef_Undef);
       solver_statistics.nr_decisions++;
     } else {
       decision_heuristic->notifyConflict(constraint_type);
+      restart_scheduler->notifyTrailSize(variable_data_store->trailSize());
       uint32_t decision_level_backtrack_before;
       Literal unit_literal;
       vector<Literal> literal_vector; // Represents a learned constraint or a set of new dependencies to be learned.
@@ -463,17 +543,31 @@ lbool QCDCL_solver::solve() {
           assert(is_learned_constraint_unit || !dependency_manager->isEligibleOOO(var(unit_literal)));
         }
       } else {
+        PROFILE_PHASE(*this, dependency_learning);
         solver_statistics.backtracks_dep++;
         Variable unit_variable = var(unit_literal);
-        dependency_manager->learnDependencies(unit_variable, literal_vector);
         auto decision_level_backtrack_before = variable_data_store->varDecisionLevel(unit_variable);
+        if (learning_engine->batchesDependencyConflicts()) {
+          // Variables resolved on later in the analysis were assigned no later than unit_variable.
+          auto& dependency_batch = learning_engine->dependencyBatch();
+          for (auto& conflict: dependency_batch) {
+            decision_level_backtrack_before = std::min(decision_level_backtrack_before, variable_data_store->varDecisionLevel(conflict.first));
+          }
+          solver_statistics.nr_dependency_conflicts += dependency_batch.size();
+          dependency_manager->learnDependencyBatch(dependency_batch);
+        } else {
+          solver_statistics.nr_dependency_conflicts++;
+          dependency_manager->learnDependencies(unit_variable, literal_vector);
+        }
         backtrackBefore(decision_level_backtrack_before);
       }
       constraint_database->notifyConflict(constraint_type);
       restart_scheduler->notifyConflict(constraint_type);
       if (restart_scheduler->restart()) {
+        solver_statistics.nr_restarts++;
         restart();
         constraint_database->notifyRestart();
+        decision_heuristic->notifyRestart();
       }
     }
   }
@@ -502,11 +596,13 @@ void QCDCL_solver::undoLast() {
 }
 
 void QCDCL_solver::backtrackBefore(uint32_t target_decision_level) {
+  PROFILE_PHASE(*this, backtracking);
   solver_statistics.backtracks_total++;
   LOG(trace) << "Backtracking before decision level: " << target_decision_level << std::endl;
   // WARNING: for out of order decisions to work properly, the following two notifications must be performed in this order
   propagator->notifyBacktrack(target_decision_level);
   decision_heuristic->notifyBacktrack(target_decision_level); // Target decision level must be passed to the VMTF decision heuristic.
+  decision_heuristic->updateTargetPhases();
   while (!variable_data_store->trailIsEmpty() && variable_data_store->decisionLevel() >= target_decision_level) {
     undoLast();
   }
@@ -2,6 +2,7 @@
 #define qcdcl_hh
 
 #include "pcnf_container.hh"
+#include "phase_profiler.hh"
 #include <vector>
 
 namespace Qute {
@@ -18,6 +19,7 @@ class DebugHelper;
 class ModelGenerator;
 class RestartScheduler;
 class ExternalPropagator;
+class HeuristicEventWriter;
 
 class QCDCL_solver: public PCNFContainer {
 
@@ -26,6 +28,7 @@ public:
   virtual ~QCDCL_solver();
   // Methods required by PCNFContainer.
   virtual void addVariable(string original_name, char variable_type, bool auxiliary);
+  virtual void addVariable(Variable original_id, char variable_type, bool auxiliary);
   virtual CRef addConstraint(std::vector<Literal>& literals, ConstraintType constraint_type);
   virtual void addDependency(Variable of, Variable on);
   virtual void notifyMaxVarDeclaration(Variable max_var);
@@ -61,6 +64,9 @@ public:
   // External Propagator (for SMS and others)
   ExternalPropagator* ext_prop = NULL;
 
+  // Receives dependencies learned during search when heuristic events are recorded.
+  HeuristicEventWriter* heuristic_event_writer = NULL;
+
   struct SolverStats
   {
     uint64_t backtracks_total = 0;
@@ -68,13 +74,18 @@ public:
     uint64_t dep_conflicts_resolved = 0;
     uint64_t nr_decisions = 0;
     uint64_t nr_assignments = 0;
+    uint64_t nr_restarts = 0;
     uint64_t learned_total[2] = {0, 0};
     uint64_t learned_tautological[2] = {0, 0};
     uint64_t learned_asserting[2] = {0, 0};
     uint64_t nr_dependencies = 0; // learned by dependency learning
+    uint64_t nr_dependency_conflicts = 0; // illegal merges dependencies were learned from
+    uint64_t nr_prefetched_dependencies = 0; // learned for variables that caused dependency conflicts before
     uint64_t nr_independencies = 0; // proved by dependency scheme
+    uint64_t nr_invalidated_independence_sets = 0; // by clauses added during search
     uint64_t nr_depscheme_reduced_lits = 0;
     clock_t  time_spent_computing_depscheme = 0;
+    double   wall_time_precomputing_depscheme = 0; // in seconds
     clock_t  time_spent_reducing_by_depscheme = 0;
     uint32_t initial_terms_generated = 0;
     double   average_initial_term_size = 0;
@@ -82,6 +93,10 @@ public:
     uint64_t spurious_watch_events = 0;
   } solver_statistics;
 
+#ifdef PHASE_PROFILING
+  PhaseProfiler phase_profiler;
+#endif
+
   struct SolverOptions
   {
     bool trace = true;
@@ -99,6 +114,7 @@ public:
 
 protected:
   void undoLast();
+  void initializeVariable(char variable_type, bool auxiliary);
   void backtrackBefore(uint32_t target_decision_level);
   void restart();
   uint64_t computeNrTrivial();
@@ -0,0 +1,321 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "main.hh"
+#include "binary_image.hh"
+#include "constraint_DB.hh"
+#include "debug_helper.hh"
+#include "decision_heuristic_SGDB.hh"
+#include "decision_heuristic_VMTF_deplearn.hh"
+#include "decision_heuristic_VMTF_prefix.hh"
+#include "decision_heuristic_VSIDS_deplearn.hh"
+#include "decision_heuristic_VSIDS_prefix.hh"
+#include "dependency_manager_watched.hh"
+#include "heuristic_event_log.hh"
+#include "parser.hh"
+#include "qcdcl.hh"
+#include "variable_data.hh"
+#include "watched_literal_propagator.hh"
+
+using namespace Qute;
+using std::cerr;
+using std::cout;
+using std::ifstream;
+using std::string;
+
+static const char USAGE[] =
+R"(Usage: qute-bench [options] <path> <events>
+
+Replays the heuristic events recorded by qute --record-heuristic-events while solving <path>
+against a decision heuristic, without propagation or conflict analysis, and reports the time
+spent in the heuristic per event. The trail always follows the recording, decisions that differ
+from the recorded ones are only counted.
+
+Options:
+  --decision-heuristic arg              decision heuristic to replay the events against [default: VMTF]
+                                        (VSIDS | VMTF | SGDB; runs without dependency learning use
+                                        VSIDS-prefix for VSIDS and VMTF-prefix otherwise)
+  --vsids-queue arg                     priority queue of VSIDS (heap, buckets) [default: heap]
+)";
+
+static const char* event_names[] = {"decision assigned", "propagation assigned", "unassigned", "backtrack",
+                                    "decision", "conflict", "learned", "dependency"};
+static const uint32_t nr_event_types = sizeof(event_names) / sizeof(event_names[0]);
+
+// Counts last-level cache misses of this process while enabled, if the kernel lets us.
+class CacheMissCounter {
+
+public:
+  CacheMissCounter() {
+    perf_event_attr attributes;
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    fd = syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+  }
+  ~CacheMissCounter() {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+  bool available() const { return fd >= 0; }
+  void start() {
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+  uint64_t stop() {
+    uint64_t count = 0;
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+      return 0;
+    }
+    return count;
+  }
+
+private:
+  int fd;
+
+};
+
+typedef std::chrono::steady_clock bench_clock;
+
+// Average cost of taking the two timestamps around a timed call, subtracted from each measurement.
+static double clockOverhead() {
+  const int rounds = 1 << 20;
+  auto begin = bench_clock::now();
+  for (int i = 0; i < rounds; i++) {
+    bench_clock::now();
+  }
+  auto end = bench_clock::now();
+  return std::chrono::duration<double, std::nano>(end - begin).count() / rounds;
+}
+
+static void corrupt_log_error(const string& filename) {
+  cerr << "qute error: Heuristic event log '" << filename << "' does not match the formula" << std::endl;
+  exit(1);
+}
+
+int main(int argc, const char** argv)
+{
+  std::map<std::string, docopt::value> args = docopt::docopt(USAGE, { argv + 1, argv + argc }, true, "qute-bench");
+
+  vector<string> decision_heuristics = {"VSIDS", "VMTF", "SGDB"};
+  ListConstraint heuristic_constraint(decision_heuristics, "--decision-heuristic");
+  vector<string> VSIDS_queues = {"heap", "buckets"};
+  ListConstraint queue_constraint(VSIDS_queues, "--vsids-queue");
+  for (ArgumentConstraint* constraint: {static_cast<ArgumentConstraint*>(&heuristic_constraint), static_cast<ArgumentConstraint*>(&queue_constraint)}) {
+    if (!constraint->check(args)) {
+      cout << constraint->message() << "\n\n";
+      cout << USAGE;
+      return 0;
+    }
+  }
+
+  string event_file = args["<events>"].asString();
+  HeuristicEventLogHeader header;
+  vector<uint32_t> events;
+  readHeuristicEventLog(event_file, header, events);
+  bool prefix_mode = header.flags & heuristic_event_log_prefix_mode;
+  bool use_model_generation = header.flags & heuristic_event_log_model_generation;
+
+  // Set up the solver as qute does with default options, minus everything only used during search.
+  QCDCL_solver solver(1e52);
+  solver.options.trace = false;
+  ConstraintDB constraint_database(solver, false, 0.999, 4000, 500, 4000, 500, 0.5, 0.5, false, 1, 2);
+  solver.constraint_database = &constraint_database;
+  DebugHelper debug_helper(solver);
+  solver.debug_helper = &debug_helper;
+  VariableDataStore variable_data_store(solver);
+  solver.variable_data_store = &variable_data_store;
+  DependencyManagerWatched dependency_manager(solver, prefix_mode ? "off" : "all", "off");
+  solver.dependency_manager = &dependency_manager;
+  string heuristic_name = args["--decision-heuristic"].asString();
+  unique_ptr<DecisionHeuristic> decision_heuristic;
+  if (prefix_mode && heuristic_name == "VSIDS") {
+    heuristic_name = "VSIDS-prefix";
+    decision_heuristic = make_unique<DecisionHeuristicVSIDSprefix>(solver, false, 0.95, 1);
+  } else if (prefix_mode) {
+    heuristic_name = "VMTF-prefix";
+    decision_heuristic = make_unique<DecisionHeuristicVMTFprefix>(solver, false);
+  } else if (heuristic_name == "VMTF") {
+    decision_heuristic = make_unique<DecisionHeuristicVMTFdeplearn>(solver, false);
+  } else if (heuristic_name == "VSIDS") {
+    decision_heuristic = make_unique<DecisionHeuristicVSIDSdeplearn>(solver, false, 0.95, 1, false, false, false, args["--vsids-queue"].asString() == "buckets");
+  } else {
+    decision_heuristic = make_unique<DecisionHeuristicSGDB>(solver, false, 0.8, 2e-6, 0.12, 0.1);
+  }
+  solver.decision_heuristic = decision_heuristic.get();
+  decision_heuristic->setPhaseHeuristic(DecisionHeuristic::PhaseHeuristicOption::WATCHER);
+  WatchedLiteralPropagator propagator(solver);
+  solver.propagator = &propagator;
+
+  string filename = args["<path>"].asString();
+  ifstream ifs(filename);
+  if (!ifs.is_open()) {
+    cerr << "qute-bench: cannot access '" << filename << "': no such file or directory \n";
+    return 2;
+  } else if (isBinaryImage(filename)) {
+    ifs.close();
+    readBinaryImage(filename, solver, use_model_generation);
+  } else {
+    Parser parser(solver, use_model_generation);
+    parser.readAUTO(ifs);
+  }
+  if (static_cast<uint32_t>(variable_data_store.lastVariable()) != header.nr_variables) {
+    corrupt_log_error(event_file);
+  }
+
+  constraint_database.notifyStart();
+  dependency_manager.notifyStart();
+  decision_heuristic->notifyStart();
+
+  double overhead = clockOverhead();
+  double nanoseconds[nr_event_types] = {0};
+  uint64_t counts[nr_event_types] = {0};
+  uint64_t divergent_decisions = 0;
+  uint32_t max_literal = 2 * header.nr_variables + 1;
+  vector<Literal> literals;
+  vector<Literal> conflict_side_literals;
+  auto literalAt = [&](size_t i) {
+    if (i >= events.size() || events[i] > max_literal || events[i] < Min_Literal_Int) {
+      corrupt_log_error(event_file);
+    }
+    return toLiteral(events[i]);
+  };
+
+  CacheMissCounter cache_misses;
+  if (cache_misses.available()) {
+    cache_misses.start();
+  }
+  auto replay_begin = bench_clock::now();
+  for (size_t i = 0; i < events.size(); i++) {
+    HeuristicEvent type = static_cast<HeuristicEvent>(events[i] & 7);
+    uint32_t payload = events[i] >> 3;
+    bench_clock::time_point begin, end;
+    switch (type) {
+      case event_decision_assigned:
+      case event_propagation_assigned: {
+        Literal l = toLiteral(payload);
+        if (payload > max_literal || payload < Min_Literal_Int || variable_data_store.isAssigned(var(l))) {
+          corrupt_log_error(event_file);
+        }
+        // Any constraint reference other than CRef_Undef marks a propagation, the reason itself is never looked at.
+        variable_data_store.appendToTrail(l, type == event_decision_assigned ? CRef_Undef : 0);
+        begin = bench_clock::now();
+        decision_heuristic->notifyAssigned(l);
+        dependency_manager.notifyAssigned(var(l));
+        end = bench_clock::now();
+        break;
+      }
+      case event_unassigned: {
+        if (variable_data_store.trailIsEmpty() || static_cast<uint32_t>(toInt(variable_data_store.popFromTrail())) != payload) {
+          corrupt_log_error(event_file);
+        }
+        begin = bench_clock::now();
+        decision_heuristic->notifyUnassigned(toLiteral(payload));
+        end = bench_clock::now();
+        break;
+      }
+      case event_backtrack:
+        begin = bench_clock::now();
+        decision_heuristic->notifyBacktrack(payload);
+        end = bench_clock::now();
+        break;
+      case event_decision: {
+        begin = bench_clock::now();
+        Literal l = decision_heuristic->getDecisionLiteral();
+        end = bench_clock::now();
+        if (var(l) != var(toLiteral(payload))) {
+          // The trail goes on with the recorded decision, so the heuristic has to keep offering its own choice.
+          divergent_decisions++;
+          if (l != Literal_Undef && dependency_manager.isDecisionCandidate(var(l))) {
+            decision_heuristic->notifyEligible(var(l));
+          }
+        }
+        break;
+      }
+      case event_conflict:
+        begin = bench_clock::now();
+        decision_heuristic->notifyConflict(static_cast<ConstraintType>(payload));
+        end = bench_clock::now();
+        break;
+      case event_learned: {
+        if (i + 1 >= events.size()) {
+          corrupt_log_error(event_file);
+        }
+        literals.resize(events[++i]);
+        for (Literal& l: literals) {
+          l = literalAt(++i);
+        }
+        if (i + 1 >= events.size()) {
+          corrupt_log_error(event_file);
+        }
+        conflict_side_literals.resize(events[++i]);
+        for (Literal& l: conflict_side_literals) {
+          l = literalAt(++i);
+        }
+        ConstraintType constraint_type = static_cast<ConstraintType>(payload & 1);
+        CRef constraint_reference = constraint_database.addConstraint(literals, constraint_type, true, false);
+        Constraint& constraint = constraint_database.getConstraint(constraint_reference, constraint_type);
+        begin = bench_clock::now();
+        decision_heuristic->notifyLearned(constraint, constraint_type, conflict_side_literals);
+        end = bench_clock::now();
+        break;
+      }
+      case event_dependency: {
+        if (i + 1 >= events.size()) {
+          corrupt_log_error(event_file);
+        }
+        Variable of = payload;
+        Variable on = events[++i];
+        if (of < 1 || on < 1 || static_cast<uint32_t>(of) > header.nr_variables || static_cast<uint32_t>(on) > header.nr_variables) {
+          corrupt_log_error(event_file);
+        }
+        begin = end = bench_clock::now();
+        dependency_manager.addDependency(of, on);
+        break;
+      }
+      default:
+        corrupt_log_error(event_file);
+    }
+    nanoseconds[type] += std::chrono::duration<double, std::nano>(end - begin).count();
+    counts[type]++;
+  }
+  auto replay_end = bench_clock::now();
+  uint64_t nr_cache_misses = cache_misses.available() ? cache_misses.stop() : 0;
+
+  uint64_t nr_events = 0;
+  double heuristic_nanoseconds = 0;
+  cout << "Decision heuristic: " << heuristic_name << "\n";
+  cout << std::fixed << std::setprecision(1);
+  for (uint32_t type = 0; type < nr_event_types; type++) {
+    if (type == event_dependency || counts[type] == 0) {
+      continue;
+    }
+    double net = std::max(0.0, nanoseconds[type] - counts[type] * overhead);
+    cout << std::left << std::setw(22) << event_names[type] << std::right << std::setw(12) << counts[type] << " events "
+         << std::setw(10) << net / counts[type] << " ns/event\n";
+    nr_events += counts[type];
+    heuristic_nanoseconds += net;
+  }
+  cout << "Heuristic events: " << nr_events << ", " << heuristic_nanoseconds / std::max<uint64_t>(nr_events, 1) << " ns/event\n";
+  cout << "Replay wall time (ms): " << std::chrono::duration<double, std::milli>(replay_end - replay_begin).count() << "\n";
+  if (cache_misses.available()) {
+    cout << "Cache misses during replay: " << nr_cache_misses << ", "
+         << double(nr_cache_misses) / std::max<uint64_t>(nr_events, 1) << " per event\n";
+  } else {
+    cout << "Cache misses during replay: unavailable\n";
+  }
+  cout << "Decisions differing from the recording: " << divergent_decisions << "\n";
+  return 0;
+}
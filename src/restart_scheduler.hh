@@ -12,6 +12,9 @@ public:
   virtual void notifyConflict(ConstraintType constraint_type) = 0;
   virtual void notifyLearned(Constraint& c) = 0;
   virtual bool restart() = 0;
+  // Called when a conflict or solution is found, before backtracking.
+  virtual void notifyTrailSize(size_t trail_size) {}
+  virtual uint64_t nrBlockedRestarts() const { return 0; }
 
 };
 
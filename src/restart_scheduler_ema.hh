@@ -13,25 +13,45 @@ using std::pow;
 
 namespace Qute {
 
+/* Restarts when the short-term average LBD of learned clauses (terms) gets
+ * too large compared to the long-term average. Either only the type of the
+ * constraint just learned is checked, or the ratios of both types, each
+ * divided by its threshold, are averaged. As in Glucose, restarts can be
+ * blocked while the trail is much longer than usual, since the solver may
+ * be close to a solution (or a refutation). */
 class RestartSchedulerEMA: public RestartScheduler {
 
 public:
-  RestartSchedulerEMA(double alpha, uint32_t minimum_distance, double threshold_factor): alpha(alpha), ema_long_term{0, 0}, ema_short_term{0, 0}, threshold_factor(threshold_factor), minimum_distance(minimum_distance), conflict_counter(0), restart_flag(false), nr_updates(0) {}
+  RestartSchedulerEMA(double alpha, uint32_t minimum_distance, double threshold_factor, double term_threshold_factor, bool combine_signals, double blocking_factor): alpha(alpha), ema_long_term{0, 0}, ema_short_term{0, 0}, threshold_factor{threshold_factor, term_threshold_factor}, combine_signals(combine_signals), minimum_distance(minimum_distance), conflict_counter(0), restart_flag(false), nr_updates(0), nr_updates_of_type{0, 0}, blocking_factor(blocking_factor), ema_trail_size(0), nr_trail_updates(0), blocking(false), nr_blocked_restarts(0) {}
   virtual void notifyConflict(ConstraintType constraint_type);
   virtual void notifyLearned(Constraint& c);
   virtual bool restart();
+  virtual void notifyTrailSize(size_t trail_size);
+  virtual uint64_t nrBlockedRestarts() const;
 
 protected:
+  double signal(bool index);
+
   double alpha;
   double ema_long_term[2];
   double ema_short_term[2];
-  double threshold_factor;
+  double threshold_factor[2];
+  bool combine_signals;
   uint32_t minimum_distance;
   uint32_t conflict_counter;
   bool restart_flag;
   uint32_t nr_updates;
+  uint32_t nr_updates_of_type[2];
   ConstraintType conflict_constraint_type;
 
+  double blocking_factor;
+  double ema_trail_size;
+  uint32_t nr_trail_updates;
+  bool blocking;
+  uint64_t nr_blocked_restarts;
+  // Weight of a new trail size, averaging over about the last 5000 conflicts as Glucose does.
+  static constexpr double trail_alpha = 2e-4;
+
 };
 
 // Implementation of inline methods.
@@ -47,12 +67,53 @@ inline void RestartSchedulerEMA::notifyLearned(Constraint& c) {
   double alpha_smoothed = (nr_updates > -log2(alpha)) ? alpha : 1 / pow(2, nr_updates);
   ema_short_term[index] = c.LBD() * alpha_smoothed + ema_short_term[index] * (1 - alpha_smoothed);
   nr_updates++;
-  if (ema_short_term[index] > ema_long_term[index] * threshold_factor && conflict_counter >= minimum_distance) {
+  nr_updates_of_type[index]++;
+  if (conflict_counter < minimum_distance) {
+    return;
+  }
+  if (combine_signals) {
+    // A type without learned constraints contributes a neutral signal.
+    if ((signal(false) + signal(true)) / 2 > 1) {
+      restart_flag = true;
+    }
+  } else if (ema_short_term[index] > ema_long_term[index] * threshold_factor[index]) {
     restart_flag = true;
   }
 }
 
+inline double RestartSchedulerEMA::signal(bool index) {
+  if (nr_updates_of_type[index] == 0) {
+    return 1;
+  }
+  return ema_short_term[index] / (ema_long_term[index] * threshold_factor[index]);
+}
+
+inline void RestartSchedulerEMA::notifyTrailSize(size_t trail_size) {
+  if (blocking_factor == 0) {
+    return;
+  }
+  double alpha_smoothed = (nr_trail_updates > -log2(trail_alpha)) ? trail_alpha : 1 / pow(2, nr_trail_updates);
+  bool warmed_up = nr_trail_updates >= 1 / trail_alpha;
+  blocking = warmed_up && trail_size > blocking_factor * ema_trail_size;
+  ema_trail_size = trail_size * alpha_smoothed + ema_trail_size * (1 - alpha_smoothed);
+  nr_trail_updates++;
+}
+
+inline uint64_t RestartSchedulerEMA::nrBlockedRestarts() const {
+  return nr_blocked_restarts;
+}
+
 inline bool RestartSchedulerEMA::restart() {
+  if (blocking) {
+    // Postpone restarting by at least the minimum distance. Like Glucose, count a blocked restart if one was allowed.
+    if (restart_flag || conflict_counter >= minimum_distance) {
+      nr_blocked_restarts++;
+    }
+    blocking = false;
+    restart_flag = false;
+    conflict_counter = 0;
+    return false;
+  }
   if (restart_flag) {
     LOG(info) << "Restarting after " << conflict_counter << " conflicts/solutions. " << std::endl;
     restart_flag = false;
@@ -0,0 +1,80 @@
+#ifndef restart_scheduler_mode_switch_hh
+#define restart_scheduler_mode_switch_hh
+
+#include <memory>
+#include "restart_scheduler.hh"
+#include "decision_heuristic_mode_switch.hh"
+#include "logging.hh"
+
+using std::unique_ptr;
+
+namespace Qute {
+
+/* Alternates between a focused and a stable mode of search, each with its
+ * own restart scheduler and decision heuristic. The first mode is focused
+ * and lasts mode_length conflicts, every following one mode_length_multiplier
+ * times as long as the one before. Switching modes restarts. Both schedulers
+ * see every event, but only the one of the current mode decides restarts. */
+class RestartSchedulerModeSwitch: public RestartScheduler {
+
+public:
+  RestartSchedulerModeSwitch(DecisionHeuristicModeSwitch& heuristic, unique_ptr<RestartScheduler> focused, unique_ptr<RestartScheduler> stable, uint32_t mode_length, double mode_length_multiplier);
+  virtual void notifyConflict(ConstraintType constraint_type);
+  virtual void notifyLearned(Constraint& c);
+  virtual bool restart();
+  virtual void notifyTrailSize(size_t trail_size);
+  virtual uint64_t nrBlockedRestarts() const;
+
+protected:
+  DecisionHeuristicModeSwitch& heuristic;
+  unique_ptr<RestartScheduler> schedulers[2]; // indexed by whether the mode is stable
+  double mode_length;
+  double mode_length_multiplier;
+  uint64_t conflict_counter;
+
+};
+
+// Implementation of inline methods.
+
+inline RestartSchedulerModeSwitch::RestartSchedulerModeSwitch(DecisionHeuristicModeSwitch& heuristic, unique_ptr<RestartScheduler> focused, unique_ptr<RestartScheduler> stable, uint32_t mode_length, double mode_length_multiplier): heuristic(heuristic), schedulers{std::move(focused), std::move(stable)}, mode_length(mode_length), mode_length_multiplier(mode_length_multiplier), conflict_counter(0) {}
+
+inline void RestartSchedulerModeSwitch::notifyConflict(ConstraintType constraint_type) {
+  conflict_counter++;
+  for (auto& scheduler: schedulers) {
+    scheduler->notifyConflict(constraint_type);
+  }
+}
+
+inline void RestartSchedulerModeSwitch::notifyLearned(Constraint& c) {
+  for (auto& scheduler: schedulers) {
+    scheduler->notifyLearned(c);
+  }
+}
+
+inline bool RestartSchedulerModeSwitch::restart() {
+  if (conflict_counter >= mode_length) {
+    bool stable = !heuristic.isStable();
+    LOG(info) << "Switching to " << (stable ? "stable" : "focused") << " mode after " << conflict_counter << " conflicts/solutions. " << std::endl;
+    heuristic.setStable(stable);
+    // The restart for the switch takes care of any restart the new mode's scheduler has pending.
+    schedulers[stable]->restart();
+    conflict_counter = 0;
+    mode_length *= mode_length_multiplier;
+    return true;
+  }
+  return schedulers[heuristic.isStable()]->restart();
+}
+
+inline void RestartSchedulerModeSwitch::notifyTrailSize(size_t trail_size) {
+  for (auto& scheduler: schedulers) {
+    scheduler->notifyTrailSize(trail_size);
+  }
+}
+
+inline uint64_t RestartSchedulerModeSwitch::nrBlockedRestarts() const {
+  return schedulers[false]->nrBlockedRestarts() + schedulers[true]->nrBlockedRestarts();
+}
+
+}
+
+#endif
@@ -38,7 +38,9 @@ template <class LiteralContainer> inline void SimpleTracer::printConstraint(Lite
   file_stream << ++running_constraint_id << " ";
   file_stream << (constraint_type == ConstraintType::clauses ? 0 : 1) << " ";
   for (auto& l: container) {
-    file_stream <<  (sign(l) ? "": "-") << solver.variable_data_store->originalName(var(l)) << " ";
+    file_stream <<  (sign(l) ? "": "-");
+    solver.variable_data_store->printOriginalName(file_stream, var(l));
+    file_stream << " ";
   }
   file_stream << "0 ";
 }
@@ -75,7 +77,8 @@ void SimpleTracer::printPrefix() {
     if (v == 1 || v_type != solver.variable_data_store->varType(v-1)) {
       file_stream << (v_type ? "a": "e") << " ";
     }
-    file_stream << solver.variable_data_store->originalName(v) << " ";
+    solver.variable_data_store->printOriginalName(file_stream, v);
+    file_stream << " ";
     if (v == solver.variable_data_store->lastVariable() || v_type != solver.variable_data_store->varType(v+1)) {
       file_stream << "0 \n";
     }
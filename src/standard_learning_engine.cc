@@ -6,7 +6,7 @@
 
 namespace Qute {
 
-StandardLearningEngine::StandardLearningEngine(QCDCL_solver& solver, bool use_depscheme_for_clauses, bool use_depscheme_for_terms): solver(solver) {
+StandardLearningEngine::StandardLearningEngine(QCDCL_solver& solver, bool use_depscheme_for_clauses, bool use_depscheme_for_terms, bool batch_dependency_conflicts): solver(solver), batch_dependency_conflicts(batch_dependency_conflicts) {
   use_depscheme_for_qtype[0] = use_depscheme_for_clauses;
   use_depscheme_for_qtype[1] = use_depscheme_for_terms;
 }
@@ -16,6 +16,7 @@ StandardLearningEngine::StandardLearningEngine(QCDCL_solver& solver, bool use_de
  * is unit propositionally, but which is unconstrained on secondaries (other than not being disabled)
  */
 bool StandardLearningEngine::analyzeConflict(CRef conflict_constraint_reference, ConstraintType constraint_type, vector<Literal>& literal_vector, uint32_t& decision_level_backtrack_before, Literal& unit_literal, bool& constraint_learned, vector<Literal>& conflict_side_literals, vector<uint32_t>& premises, bool& result_is_tainted) {
+  PROFILE_PHASE(solver, conflict_analysis);
   Constraint& constraint = solver.constraint_database->getConstraint(conflict_constraint_reference, constraint_type);
   if (solver.options.trace) {
     premises.push_back(constraint.id());
@@ -105,6 +106,11 @@ bool StandardLearningEngine::analyzeConflict(CRef conflict_constraint_reference,
       // Illegal merge. Set return values and exit.
       unit_literal = primary_assigned_last;
       constraint_learned = false;
+      if (batch_dependency_conflicts) {
+        dependency_batch.clear();
+        dependency_batch.emplace_back(var(primary_assigned_last), literal_vector);
+        collectDependencyConflicts(characteristic_function, constraint_type, rightmost_primary, primary_literal_decision_level_counts, primary_trail);
+      }
       return false;
     }
   }
@@ -114,6 +120,45 @@ bool StandardLearningEngine::analyzeConflict(CRef conflict_constraint_reference,
   return false;
 }
 
+/* Continues the resolution derivation past an illegal merge, as if the dependencies of the
+ * merges were already learned, and records every further illegal merge in dependency_batch.
+ * The derived constraint is discarded, so unlike analyzeConflict this neither bumps constraint
+ * activities nor records premises. Analysis stops where analyzeConflict would learn a constraint.
+ */
+void StandardLearningEngine::collectDependencyConflicts(vector<bool>& characteristic_function, ConstraintType constraint_type, Literal rightmost_primary, vector<uint32_t>& primary_literal_decision_level_counts, vector<Literal>& primary_trail) {
+  vector<Literal> blocking_literals;
+  while (true) {
+    // Illegal merges skip reduction, so the rightmost primary may have been resolved away.
+    while (rightmost_primary != Literal_Undef && !(characteristic_function[toInt(rightmost_primary)] && solver.variable_data_store->varType(var(rightmost_primary)) == constraint_type)) {
+      rightmost_primary = toInt(rightmost_primary) > Min_Literal_Int ? toLiteral(toInt(rightmost_primary) - 1) : Literal_Undef;
+    }
+    if (rightmost_primary == Literal_Undef) {
+      return;
+    }
+    Literal primary_assigned_last = Literal_Undef;
+    while (!primary_trail.empty() && primary_assigned_last == Literal_Undef) {
+      Literal candidate = ~(primary_trail.back() ^ constraint_type);
+      primary_trail.pop_back();
+      if (characteristic_function[toInt(candidate)]) {
+        primary_assigned_last = candidate;
+      }
+    }
+    if (primary_assigned_last == Literal_Undef || isAsserting(primary_assigned_last, characteristic_function, primary_literal_decision_level_counts, constraint_type)) {
+      return;
+    }
+    CRef reason_reference = solver.variable_data_store->varReason(var(primary_assigned_last));
+    if (reason_reference == CRef_Undef) {
+      return;
+    }
+    Constraint& reason = solver.constraint_database->getConstraint(reason_reference, constraint_type);
+    resolveAndReduce(characteristic_function, reason, constraint_type, primary_assigned_last, rightmost_primary, primary_literal_decision_level_counts, blocking_literals);
+    if (!blocking_literals.empty()) {
+      dependency_batch.emplace_back(var(primary_assigned_last), blocking_literals);
+      blocking_literals.clear();
+    }
+  }
+}
+
 vector<bool> StandardLearningEngine::constraintToCf(Constraint& constraint, ConstraintType constraint_type, Literal& rightmost_primary) {
   vector<bool> characteristic_function(solver.variable_data_store->lastVariable() + solver.variable_data_store->lastVariable() + 2);
   fill(characteristic_function.begin(), characteristic_function.end(), false);
@@ -289,7 +334,7 @@ string StandardLearningEngine::reducedLast() {
     bool first_type =  solver.variable_data_store->varType(1);
     for (Variable v = 1; v <= solver.variable_data_store->lastVariable() && solver.variable_data_store->varType(v) == first_type; v++) {
       out_string += ((reduced_last[v] != first_type) ? "" : "-");
-      out_string += solver.variable_data_store->originalName(v);
+      solver.variable_data_store->appendOriginalName(out_string, v);
       out_string += " ";
     }
   }
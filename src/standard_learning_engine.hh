@@ -4,12 +4,14 @@
 #include <vector>
 #include <algorithm>
 #include <string>
+#include <utility>
 #include "learning_engine.hh"
 #include "solver_types.hh"
 #include "constraint.hh"
 
 using std::vector;
 using std::string;
+using std::pair;
 
 namespace Qute {
 
@@ -18,13 +20,17 @@ class QCDCL_solver;
 class StandardLearningEngine: public LearningEngine {
 
 public:
-  StandardLearningEngine(QCDCL_solver& solver, bool use_depscheme_for_clauses, bool use_depscheme_for_terms);
+  StandardLearningEngine(QCDCL_solver& solver, bool use_depscheme_for_clauses, bool use_depscheme_for_terms, bool batch_dependency_conflicts = false);
   virtual bool analyzeConflict(CRef conflict_constraint_reference, ConstraintType constraint_type, 
                                vector<Literal>& literal_vector, uint32_t& decision_level_backtrack_before, 
                                Literal& unit_literal, bool& constraint_learned, vector<Literal>& conflict_side_literals,
                                vector<uint32_t>& premises, bool& result_is_tainted);
   string reducedLast();
   bool reducedLast(Variable v);
+  bool batchesDependencyConflicts() const;
+  /* In batched mode, all illegal merges (unit variable and blocking literals) met by the
+   * last conflict analysis that did not learn a constraint, starting with the one returned. */
+  vector<pair<Variable, vector<Literal>>>& dependencyBatch();
 
 protected:
   vector<bool> constraintToCf(Constraint& constraint, ConstraintType constraint_type, Literal& rightmost_primary);
@@ -34,6 +40,7 @@ protected:
   bool isAsserting(Literal last_literal, vector<bool>& characteristic_function, vector<uint32_t>& primary_literal_decision_level_counts, ConstraintType constraint_type);
   bool isPseudoAsserting(Literal last_literal, vector<bool>& characteristic_function, vector<uint32_t>& primary_literal_decision_level_counts, ConstraintType constraint_type);
   void resolveAndReduce(vector<bool>& characteristic_function, Constraint& reason, ConstraintType constraint_type, Literal pivot, Literal& rightmost_primary, vector<uint32_t>& primary_literal_decision_level_counts, vector<Literal>& literal_vector);
+  void collectDependencyConflicts(vector<bool>& characteristic_function, ConstraintType constraint_type, Literal rightmost_primary, vector<uint32_t>& primary_literal_decision_level_counts, vector<Literal>& primary_trail);
   uint32_t computeBackTrackLevel(Literal literal, vector<bool>& characteristic_function, Literal rightmost_primary, ConstraintType constraint_type);
   uint32_t computeBackTrackLevelPseudoUnit(Literal literal, vector<bool>& characteristic_function, Literal rightmost_primary, ConstraintType constraint_type);
   string cfToString(vector<bool>& characteristic_function, Literal rightmost_primary) const;
@@ -44,6 +51,8 @@ protected:
   vector<bool> reduced_last;
   
   bool use_depscheme_for_qtype[2];
+  bool batch_dependency_conflicts;
+  vector<pair<Variable, vector<Literal>>> dependency_batch;
 };
 
 // Implementation of inline methods.
@@ -75,6 +84,14 @@ inline bool StandardLearningEngine::reducedLast(Variable v) {
   return reduced_last[v];
 }
 
+inline bool StandardLearningEngine::batchesDependencyConflicts() const {
+  return batch_dependency_conflicts;
+}
+
+inline vector<pair<Variable, vector<Literal>>>& StandardLearningEngine::dependencyBatch() {
+  return dependency_batch;
+}
+
 }
 
 #endif
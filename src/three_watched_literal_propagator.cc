@@ -143,7 +143,11 @@ CRef ThreeWatchedLiteralPropagator::propagate(ConstraintType& constraint_type) {
   if (solver.variable_data_store->allAssigned()) { 
   /* Every variable is assigned but no conflict/solution is detected.
      Use the model generation rule to obtain an initial term. */
-    vector<Literal> initial_term = solver.model_generator->generateModel();
+    vector<Literal> initial_term;
+    {
+      PROFILE_PHASE(solver, model_generation);
+      initial_term = solver.model_generator->generateModel();
+    }
     CRef initial_term_reference = solver.constraint_database->addConstraint(initial_term, ConstraintType::terms, true, false);
     auto& term = solver.constraint_database->getConstraint(initial_term_reference, ConstraintType::terms);
     term.mark(); // Immediately mark for removal upon constraint cleaning.
@@ -563,11 +567,11 @@ inline bool ThreeWatchedLiteralPropagator::constraintIsWatchedByLiteral(Constrai
 }
 
 bool ThreeWatchedLiteralPropagator::disablesConstraint(Literal literal, ConstraintType constraint_type) {
-  return isAssigned(literal) && (solver.variable_data_store->assignment(var(literal)) == sign(literal)) == disablingPolarity(constraint_type);
+  return solver.variable_data_store->isTrue(disablingLiteral(literal, constraint_type));
 }
 
 inline bool ThreeWatchedLiteralPropagator::isUnassignedOrDisablesConstraint(Literal literal, ConstraintType constraint_type) {
-  return !isAssigned(literal) || (solver.variable_data_store->assignment(var(literal)) == sign(literal)) == disablingPolarity(constraint_type);
+  return !solver.variable_data_store->isFalse(disablingLiteral(literal, constraint_type));
 }
 
 bool ThreeWatchedLiteralPropagator::isDisabled(Constraint& constraint, ConstraintType constraint_type) {
@@ -22,6 +22,7 @@ class ThreeWatchedLiteralPropagator: public Propagator {
 public:
   ThreeWatchedLiteralPropagator(QCDCL_solver& solver);
   virtual void addVariable();
+  virtual void notifyMaxVarDeclaration(Variable max_var);
   virtual CRef propagate(ConstraintType& constraint_type);
   virtual void addConstraint(CRef constraint_reference, ConstraintType constraint_type);
   virtual void notifyAssigned(Literal l);
@@ -82,6 +83,12 @@ protected:
 };
 
 // Implementation of inline methods.
+inline void ThreeWatchedLiteralPropagator::notifyMaxVarDeclaration(Variable max_var) {
+  for (ConstraintType constraint_type: constraint_types) {
+    constraints_watched_by[constraint_type].reserve(2 * (max_var + 1));
+  }
+}
+
 inline void ThreeWatchedLiteralPropagator::addVariable() {
   for (ConstraintType constraint_type: constraint_types) {
     // Add entries for both literals.
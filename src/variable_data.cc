@@ -4,7 +4,19 @@
 
 namespace Qute {
 
-VariableDataStore::VariableDataStore(QCDCL_solver& solver): solver(solver), last_variable(0), last_universal(0) {}
+VariableDataStore::VariableDataStore(QCDCL_solver& solver): literal_value(Min_Literal_Int, l_Undef), variable_type(1, 0), variable_decision_level(1, 0), variable_reason(1, CRef_Undef), solver(solver), last_variable(0), last_universal(0) {}
+
+void VariableDataStore::notifyMaxVarDeclaration(Variable max_var) {
+  trail.reserve(max_var);
+  literal_value.reserve(2 * (max_var + 1));
+  variable_type.reserve(max_var + 1);
+  variable_decision_level.reserve(max_var + 1);
+  variable_reason.reserve(max_var + 1);
+  variable_name.reserve(max_var);
+  for (auto& counts: vars_of_type_until) {
+    counts.reserve(max_var + 1);
+  }
+}
 
 Variable extract_integer_name(std::string name) {
   Variable result = 0;
@@ -23,16 +35,37 @@ Variable extract_integer_name(std::string name) {
 
 void VariableDataStore::addVariable(string original_name, bool type) {
   if (original_name == "") {
-    original_name = std::to_string(next_orig_id++);
-  } else {
-    Variable name_id = extract_integer_name(original_name);
-    if (name_id >= next_orig_id) {
-      next_orig_id = name_id + 1;
-    }
+    addVariable(next_orig_id, type);
+    return;
+  }
+  Variable name_id = extract_integer_name(original_name);
+  if (name_id != 0 && original_name.size() < 10) {
+    // The name is a canonical integer that fits into 32 bits, store the id instead.
+    addVariable(name_id, type);
+    return;
+  }
+  if (name_id >= next_orig_id) {
+    next_orig_id = name_id + 1;
   }
-  variable_name.push_back(original_name);
-  variable_data.emplace_back();
-  assignment_data.emplace_back(type);
+  variable_name.emplace_back(name_pool.size(), original_name.size());
+  name_pool += original_name;
+  pushVariableData(type);
+}
+
+void VariableDataStore::addVariable(Variable original_id, bool type) {
+  if (original_id >= next_orig_id) {
+    next_orig_id = original_id + 1;
+  }
+  variable_name.emplace_back(original_id, 0);
+  pushVariableData(type);
+}
+
+void VariableDataStore::pushVariableData(bool type) {
+  literal_value.push_back(l_Undef);
+  literal_value.push_back(l_Undef);
+  variable_type.push_back(type);
+  variable_decision_level.push_back(0);
+  variable_reason.push_back(CRef_Undef);
   last_variable++;
   if (type == true)
     last_universal = last_variable;
@@ -43,13 +76,13 @@ void VariableDataStore::addVariable(string original_name, bool type) {
 void VariableDataStore::appendToTrail(Literal l, CRef reason) {
   trail.push_back(l);
   Variable v = var(l);
-  assignment_data[v - 1].is_assigned = true;
-  assignment_data[v - 1].assignment = sign(l);
-  variable_data[v - 1].reason = reason;
+  literal_value[toInt(l)] = l_True;
+  literal_value[toInt(~l)] = l_False;
+  variable_reason[v] = reason;
   if (reason == CRef_Undef) {
     decisions.push_back(v);
   }
-  variable_data[v - 1].decision_level = decisions.size();
+  variable_decision_level[v] = decisions.size();
 }
 
 Literal VariableDataStore::popFromTrail() {
@@ -60,14 +93,15 @@ Literal VariableDataStore::popFromTrail() {
     decisions.pop_back();
   }
   trail.pop_back();
-  assignment_data[v - 1].is_assigned = false;
+  literal_value[toInt(last_literal)] = l_Undef;
+  literal_value[toInt(~last_literal)] = l_Undef;
   return last_literal;
 }
 
 void VariableDataStore::relocConstraintReferences(ConstraintType constraint_type) {
   for (Variable v = 1; v <= lastVariable(); v++) {
     if (varType(v) == constraint_type && varReason(v) != CRef_Undef) {
-      solver.constraint_database->relocate(variable_data[v - 1].reason, constraint_type);
+      solver.constraint_database->relocate(variable_reason[v], constraint_type);
     }
   }
 }
@@ -4,6 +4,7 @@
 #include "solver_types.hh"
 #include "constraint.hh"
 
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -19,11 +20,18 @@ class VariableDataStore {
 
 public:
   VariableDataStore(QCDCL_solver& solver);
+  void notifyMaxVarDeclaration(Variable max_var);
   void addVariable(string original_name, bool type);
+  void addVariable(Variable original_id, bool type);
   string originalName(Variable v) const;
+  void appendOriginalName(string& out, Variable v) const;
+  void printOriginalName(std::ostream& out, Variable v) const;
   bool varType(Variable v) const;
   bool isAssigned(Variable v) const;
   bool assignment(Variable v) const;
+  lbool literalValue(Literal l) const;
+  bool isTrue(Literal l) const;
+  bool isFalse(Literal l) const;
   void appendToTrail(Literal l, CRef reason);
   uint32_t decisionLevel() const;
   uint32_t varDecisionLevel(Variable v) const;
@@ -31,6 +39,7 @@ public:
   CRef varReason(Variable v) const;
   Literal popFromTrail();
   bool trailIsEmpty() const;
+  size_t trailSize() const;
   Variable lastVariable() const;
   Variable lastUniversal() const;
   TrailIterator trailBegin() const;
@@ -48,25 +57,30 @@ public:
   Variable getPreviousOfType(bool type, Variable x) const;
 
 protected:
-  struct AssignmentData
-  {
-    bool is_assigned: 1;
-    bool assignment: 1;
-    bool type: 1;
-    AssignmentData(bool type): is_assigned(false), assignment(false), type(type) {}
-  };
+  void pushVariableData(bool type);
 
-  struct VariableData
+  /* Per-variable data is stored as a structure of arrays indexed directly by
+   * the variable (index 0 is unused). The truth value of a literal l is kept in
+   * literal_value[toInt(l)], so checking it is a single load. */
+  vector<Literal> trail;
+  vector<lbool> literal_value;
+  vector<uint8_t> variable_type;
+  vector<uint32_t> variable_decision_level;
+  vector<CRef> variable_reason;
+
+  /* Original names are only needed for output and are kept away from the data
+   * used during search. Numeric names (all of QDIMACS and fresh auxiliary
+   * variables) are stored as the integer id and only formatted when printed,
+   * other names are interned into a single character pool. A record with
+   * length 0 holds an integer id in place of the pool offset. */
+  struct NameRecord
   {
-    uint32_t decision_level;
-    CRef reason;
-    VariableData(): reason(CRef_Undef) {}
+    uint32_t offset_or_id;
+    uint32_t length;
+    NameRecord(uint32_t offset_or_id, uint32_t length): offset_or_id(offset_or_id), length(length) {}
   };
-
-  vector<Literal> trail;
-  vector<VariableData> variable_data;
-  vector<AssignmentData> assignment_data;
-  vector<string> variable_name;
+  vector<NameRecord> variable_name;
+  string name_pool;
 
   QCDCL_solver& solver;
   Variable last_variable;
@@ -82,7 +96,7 @@ public:
   inline void rename_auxiliary_variables() {
     for (Variable v : auxiliary) {
       if (varType(v)) { // universal
-        variable_name[v - 1] = std::to_string(next_orig_id++);
+        variable_name[v - 1] = NameRecord(next_orig_id++, 0);
       }
     }
   };
@@ -91,19 +105,51 @@ public:
 // Implementation of inline methods.
 
 inline string VariableDataStore::originalName(Variable v) const {
-  return variable_name[v - 1];
+  string name;
+  appendOriginalName(name, v);
+  return name;
+}
+
+inline void VariableDataStore::appendOriginalName(string& out, Variable v) const {
+  const NameRecord& record = variable_name[v - 1];
+  if (record.length == 0) {
+    out += to_string(record.offset_or_id);
+  } else {
+    out.append(name_pool, record.offset_or_id, record.length);
+  }
+}
+
+inline void VariableDataStore::printOriginalName(std::ostream& out, Variable v) const {
+  const NameRecord& record = variable_name[v - 1];
+  if (record.length == 0) {
+    out << record.offset_or_id;
+  } else {
+    out.write(name_pool.data() + record.offset_or_id, record.length);
+  }
 }
 
 inline bool VariableDataStore::varType(Variable v) const {
-  return assignment_data[v - 1].type;
+  return variable_type[v];
 }
 
 inline bool VariableDataStore::isAssigned(Variable v) const {
-  return assignment_data[v - 1].is_assigned;
+  return literal_value[toInt(mkLiteral(v, true))] != l_Undef;
 }
 
 inline bool VariableDataStore::assignment(Variable v) const {
-  return assignment_data[v - 1].assignment;
+  return literal_value[toInt(mkLiteral(v, true))] == l_True;
+}
+
+inline lbool VariableDataStore::literalValue(Literal l) const {
+  return literal_value[toInt(l)];
+}
+
+inline bool VariableDataStore::isTrue(Literal l) const {
+  return literal_value[toInt(l)] == l_True;
+}
+
+inline bool VariableDataStore::isFalse(Literal l) const {
+  return literal_value[toInt(l)] == l_False;
 }
 
 inline uint32_t VariableDataStore::decisionLevel() const {
@@ -111,7 +157,7 @@ inline uint32_t VariableDataStore::decisionLevel() const {
 }
 
 inline uint32_t VariableDataStore::varDecisionLevel(Variable v) const {
-  return variable_data[v - 1].decision_level;
+  return variable_decision_level[v];
 }
 
 inline bool VariableDataStore::decisionLevelType(uint32_t decision_level) {
@@ -119,13 +165,17 @@ inline bool VariableDataStore::decisionLevelType(uint32_t decision_level) {
 }
 
 inline CRef VariableDataStore::varReason(Variable v) const {
-  return variable_data[v - 1].reason;
+  return variable_reason[v];
 }
 
 inline bool VariableDataStore::trailIsEmpty() const {
   return trail.empty();
 }
 
+inline size_t VariableDataStore::trailSize() const {
+  return trail.size();
+}
+
 inline Variable VariableDataStore::lastVariable() const {
   return last_variable;
 }
@@ -164,7 +214,7 @@ inline string VariableDataStore::literalVectorToString(vector<Literal>& literal_
 }
 
 inline bool VariableDataStore::allAssigned() const {
-  return trail.size() == variable_data.size();
+  return trail.size() == static_cast<size_t>(last_variable);
 }
 
 inline int VariableDataStore::countVarsOfTypeUntil(bool type, Variable x) const {
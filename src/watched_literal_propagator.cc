@@ -86,7 +86,11 @@ CRef WatchedLiteralPropagator::propagate(ConstraintType& constraint_type) {
   if (solver.variable_data_store->allAssigned()) { 
   /* Every variable is assigned but no conflict/solution is detected.
      Use the model generation rule to obtain an initial term. */
-    vector<Literal> initial_term = solver.model_generator->generateModel();
+    vector<Literal> initial_term;
+    {
+      PROFILE_PHASE(solver, model_generation);
+      initial_term = solver.model_generator->generateModel();
+    }
     CRef initial_term_reference = solver.constraint_database->addConstraint(initial_term, ConstraintType::terms, true, false);
     auto& term = solver.constraint_database->getConstraint(initial_term_reference, ConstraintType::terms);
     term.mark(); // Immediately mark for removal upon constraint cleaning.
@@ -274,15 +278,13 @@ inline uint32_t WatchedLiteralPropagator::findSecondWatcher(Constraint& constrai
 
 bool WatchedLiteralPropagator::isUnassignedOrDisablingPrimary(Literal literal, ConstraintType constraint_type) {
   return (solver.variable_data_store->varType(var(literal)) == constraint_type &&
-          (!solver.variable_data_store->isAssigned(var(literal)) ||
-           (solver.variable_data_store->assignment(var(literal)) == sign(literal)) == disablingPolarity(constraint_type)));
+          !solver.variable_data_store->isFalse(disablingLiteral(literal, constraint_type)));
 }
 
 bool WatchedLiteralPropagator::isBlockedOrDisablingSecondary(Literal literal, ConstraintType constraint_type, Literal primary) {
   return ((solver.variable_data_store->varType(var(literal)) != constraint_type && solver.dependency_manager->dependsOn(var(primary), var(literal))) &&
-          (!solver.variable_data_store->isAssigned(var(literal)) ||
-           (solver.variable_data_store->assignment(var(literal)) == sign(literal)) == disablingPolarity(constraint_type) ||
-           ((solver.variable_data_store->assignment(var(primary)) == sign(primary)) == disablingPolarity(constraint_type) &&
+          (!solver.variable_data_store->isFalse(disablingLiteral(literal, constraint_type)) ||
+           (solver.variable_data_store->isTrue(disablingLiteral(primary, constraint_type)) &&
             solver.variable_data_store->varDecisionLevel(var(primary)) <= solver.variable_data_store->varDecisionLevel(var(literal)))));
 }
 
@@ -291,7 +293,7 @@ bool WatchedLiteralPropagator::constraintIsWatchedByLiteral(Constraint& constrai
 }
 
 bool WatchedLiteralPropagator::disablesConstraint(Literal literal, ConstraintType constraint_type) {
-  return solver.variable_data_store->isAssigned(var(literal)) && (solver.variable_data_store->assignment(var(literal)) == sign(literal)) == disablingPolarity(constraint_type);
+  return solver.variable_data_store->isTrue(disablingLiteral(literal, constraint_type));
 }
 
 bool WatchedLiteralPropagator::isDisabled(Constraint& constraint, ConstraintType constraint_type) {
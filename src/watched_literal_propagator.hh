@@ -20,6 +20,7 @@ class WatchedLiteralPropagator: public Propagator {
 public:
   WatchedLiteralPropagator(QCDCL_solver& solver);
   virtual void addVariable();
+  virtual void notifyMaxVarDeclaration(Variable max_var);
   virtual CRef propagate(ConstraintType& constraint_type);
   virtual void addConstraint(CRef constraint_reference, ConstraintType constraint_type);
   virtual void notifyAssigned(Literal l);
@@ -64,6 +65,12 @@ protected:
 };
 
 // Implementation of inline methods.
+inline void WatchedLiteralPropagator::notifyMaxVarDeclaration(Variable max_var) {
+  for (ConstraintType constraint_type: constraint_types) {
+    constraints_watched_by[constraint_type].reserve(2 * (max_var + 1));
+  }
+}
+
 inline void WatchedLiteralPropagator::addVariable() {
   for (ConstraintType constraint_type: constraint_types) {
     // Add entries for both literals.